@@ -0,0 +1,219 @@
+#include <cstdlib>
+#include <queue>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include <string>
+#include <iostream>
+#include <functional>
+
+#include "utils/GraphUtils.h"
+#include "utils/LargeArrays.h"
+#include "algorithms/GraphBaseAlgorithms.h"
+#include "data_structures/compressedGraph/CompressedGraph.h"
+
+// Benchmark of the compressed adjacency (see CompressedGraph.h) against the adjacency lists of the general graph:
+// memory per arc and throughput (arcs per second) of a full BFS and of a Dijkstra with a binary heap.
+// The same traversals run on both layouts, only the way the arcs of a node are read changes.
+//
+// Usage: compressed_graph_benchmark path/filename.json [repetitions] [--memory=policy]
+//        compressed_graph_benchmark num_nodes arcs_per_node [repetitions] [--memory=policy] (random graph)
+// The policy of the large arrays is default, thp or hugetlb, optionally followed by ,interleave (see LargeArrays.h).
+
+namespace
+{
+    // random graph: each node has arcs_per_node arcs to random nodes, with random capacity and cost
+    std::shared_ptr<data_structures::Graph> randomGraph(int num_nodes, int arcs_per_node)
+    {
+        std::mt19937 generator{42};
+        std::uniform_int_distribution<int> node(0, num_nodes - 1);
+        std::uniform_int_distribution<int> capacity(1, 1000);
+        std::uniform_int_distribution<int> cost(1, 100);
+
+        auto graph = std::make_shared<data_structures::Graph>(num_nodes, true);
+        for (int u = 0; u < num_nodes; u++)
+        {
+            for (int i = 0; i < arcs_per_node; i++)
+            {
+                graph->addEdge(u, node(generator), capacity(generator), cost(generator));
+            }
+        }
+        return graph;
+    }
+
+    // memory of the adjacency lists of the general graph: the edges, the vectors with their shared pointer
+    // control blocks and the nodes of the map (key, shared pointer, three links and the color)
+    std::size_t uncompressedSizeInBytes(const std::shared_ptr<data_structures::Graph> &graph)
+    {
+        std::size_t size{};
+        for (int u = 0; u < graph->getNumNodes(); u++)
+        {
+            size += graph->getNodeAdjList(u)->capacity() * sizeof(data_structures::Edge);
+            size += sizeof(std::pmr::vector<data_structures::Edge>) + 2 * sizeof(long);
+            size += sizeof(std::pair<const int, std::shared_ptr<std::pmr::vector<data_structures::Edge>>>) + 4 * sizeof(void *);
+        }
+        return size;
+    }
+
+    // BFS visiting every node reachable from the source, it returns the number of arcs read
+    template <typename ForEachArc>
+    std::size_t bfs(int num_nodes, int source, const ForEachArc &for_each_arc)
+    {
+        std::vector<bool> visited(num_nodes, false);
+        std::vector<int> q{source};
+        visited[source] = true;
+
+        std::size_t arcs{};
+        for (std::size_t head = 0; head < q.size(); head++)
+        {
+            for_each_arc(q[head], [&](int sink, int)
+            {
+                arcs++;
+                if (!visited[sink])
+                {
+                    visited[sink] = true;
+                    q.push_back(sink);
+                }
+            });
+        }
+        return arcs;
+    }
+
+    // Dijkstra with a binary heap, it returns the number of arcs read
+    template <typename ForEachArc>
+    std::size_t dijkstra(int num_nodes, int source, const ForEachArc &for_each_arc, std::vector<int> &dist)
+    {
+        dist.assign(num_nodes, std::numeric_limits<int>::max());
+        dist[source] = 0;
+
+        std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> q{};
+        q.emplace(0, source);
+        std::size_t arcs{};
+        while (!q.empty())
+        {
+            auto [distance, node] = q.top();
+            q.pop();
+            if (distance != dist[node])
+            {
+                continue;
+            }
+
+            for_each_arc(node, [&](int sink, int cost)
+            {
+                arcs++;
+                if (distance + cost < dist[sink])
+                {
+                    dist[sink] = distance + cost;
+                    q.emplace(distance + cost, sink);
+                }
+            });
+        }
+        return arcs;
+    }
+
+    // run the traversal repetitions times, it returns the arcs read per second
+    double throughput(int repetitions, const std::function<std::size_t()> &traversal)
+    {
+        std::size_t arcs{};
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repetitions; i++)
+        {
+            arcs += traversal();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return static_cast<double>(arcs) / elapsed.count();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    // the memory option can be anywhere, the other arguments are positional
+    std::vector<std::string> arguments;
+    std::string memory_policy{"default"};
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument{argv[i]};
+        if (argument.rfind("--memory=", 0) == 0)
+        {
+            memory_policy = argument.substr(9);
+        }
+        else
+        {
+            arguments.push_back(argument);
+        }
+    }
+
+    if (arguments.empty())
+    {
+        std::cout << "Usage: " << argv[0] << " path/filename.json [repetitions] [--memory=policy]" << std::endl;
+        std::cout << "       " << argv[0] << " num_nodes arcs_per_node [repetitions] [--memory=policy]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        utils::LargeArrays::SetPolicy(memory_policy);
+
+        bool from_file{arguments[0].size() > 5 && arguments[0].substr(arguments[0].size() - 5) == ".json"};
+        auto graph = from_file ? utils::GraphUtils::CreateGraphFromJSON(arguments[0])
+                               : randomGraph(std::stoi(arguments[0]), arguments.size() > 1 ? std::stoi(arguments[1]) : 8);
+        std::size_t repetitions_position{from_file ? 1U : 2U};
+        int repetitions{arguments.size() > repetitions_position ? std::stoi(arguments[repetitions_position]) : 10};
+
+        data_structures::CompressedGraph compressed_graph(graph);
+        int num_nodes{graph->getNumNodes()};
+        auto num_arcs = static_cast<double>(std::max<std::size_t>(compressed_graph.getNumArcs(), 1));
+
+        // visit the sink and the cost of each arc of a node, inlined in the traversals
+        auto lists = [&graph](int node, auto &&visitor)
+        {
+            for (const auto &e : graph->getNodeAdjListUnchecked(node))
+            {
+                visitor(e.getSink(), e.getCost());
+            }
+        };
+        auto compressed = [&compressed_graph](int node, auto &&visitor)
+        {
+            compressed_graph.forEachArc(node, [&visitor](int sink, int, int cost)
+            {
+                visitor(sink, cost);
+            });
+        };
+
+        std::cout << "Nodes: " << num_nodes << ", arcs: " << compressed_graph.getNumArcs()
+                  << ", capacity bits: " << compressed_graph.getCapacityBits() << std::endl;
+        std::cout << "Bytes per arc: adjacency lists " << static_cast<double>(uncompressedSizeInBytes(graph)) / num_arcs
+                  << ", compressed " << static_cast<double>(compressed_graph.getSizeInBytes()) / num_arcs << std::endl;
+
+        std::cout << "BFS arcs per second: adjacency lists "
+                  << throughput(repetitions, [&]() { return bfs(num_nodes, 0, lists); })
+                  << ", compressed " << throughput(repetitions, [&]() { return bfs(num_nodes, 0, compressed); }) << std::endl;
+
+        std::vector<int> lists_dist;
+        std::vector<int> compressed_dist;
+        std::cout << "Dijkstra arcs per second: adjacency lists "
+                  << throughput(repetitions, [&]() { return dijkstra(num_nodes, 0, lists, lists_dist); })
+                  << ", compressed " << throughput(repetitions, [&]() { return dijkstra(num_nodes, 0, compressed, compressed_dist); })
+                  << std::endl;
+
+        // the traversals on the two layouts must agree with the solver on the compressed graph
+        auto dist = algorithms::GraphBaseAlgorithms::Dijkstra(compressed_graph, 0)->getDistance();
+        bool same_result{lists_dist == compressed_dist && compressed_dist == *dist};
+        std::cout << "Same distances: " << (same_result ? "yes" : "no") << std::endl;
+
+        auto stats = utils::LargeArrays::GetStats();
+        std::cout << "Large arrays (" << memory_policy << "): " << stats.allocations << " allocations, peak "
+                  << stats.peak_bytes << " bytes, explicit huge pages " << stats.explicit_huge_page_bytes
+                  << " bytes, transparent huge pages " << stats.transparent_huge_page_bytes << " bytes, interleaved "
+                  << stats.interleaved_bytes << " bytes, fallbacks " << stats.fallbacks << std::endl;
+        return same_result ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    catch (std::exception &e)
+    {
+        std::cout << "ERROR: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <optional>
 
 #include "utils/GraphUtils.h"
 #include "algorithms/MaximumFlowAlgorithms.h"
@@ -27,10 +28,34 @@ int main(int argc, char **argv)
         // read graph from file
         auto graph = utils::GraphUtils::CreateGraphFromJSON(filename);
 
+        // optional second argument: renumber the nodes for locality before solving the minimum cost flow (bfs, rcm or degree)
+        std::optional<algorithms::NodeOrder> node_order{};
+        if (argc > 2)
+        {
+            std::string order{argv[2]};
+            if (order == "bfs")
+            {
+                node_order = algorithms::NodeOrder::Bfs;
+            }
+            else if (order == "rcm")
+            {
+                node_order = algorithms::NodeOrder::ReverseCuthillMcKee;
+            }
+            else if (order == "degree")
+            {
+                node_order = algorithms::NodeOrder::Degree;
+            }
+            else
+            {
+                throw std::invalid_argument("Invalid node order (bfs, rcm or degree)!");
+            }
+        }
+
         std::cout << "Select the network flow problem:" << std::endl;
         std::cout << "1. Maximum flow (EdmondsKarp)" << std::endl;
         std::cout << "2. Minimum cost flow (Choose algorithm...)" << std::endl;
-        std::cout << "3. Exit" << std::endl;
+        std::cout << "3. Parametric maximum flow (source edges capacity * lambda)" << std::endl;
+        std::cout << "4. Exit" << std::endl;
         std::cout << "Enter your choice: ";
         int choice{};
         std::cin >> choice;
@@ -41,15 +66,40 @@ int main(int argc, char **argv)
         int sink{graph->getNumNodes() - 1};
         std::shared_ptr<dto::FlowResult> result;
 
+        // print each path (or cycle) of the flow decomposition as soon as it is found
+        auto print_path = [](const std::vector<int> &path, int flow)
+        {
+            std::cout << (path.front() == path.back() ? "cycle" : "path") << " (flow " << flow << "): ";
+            for (unsigned i = 0; i < path.size(); i++)
+            {
+                std::cout << (i ? " -> " : "") << path.at(i);
+            }
+            std::cout << std::endl;
+        };
+
+        // print the flow of each edge by id (parallel edges are reported separately)
+        auto print_edge_flow = [](const std::vector<int> &edge_flow)
+        {
+            std::cout << "Flow of each edge (by id): [";
+            for (unsigned i = 0; i < edge_flow.size(); i++)
+            {
+                std::cout << (i ? ", " : "") << edge_flow.at(i);
+            }
+            std::cout << "]" << std::endl;
+        };
+
         switch (choice)
         {
         case 1:
         {
             result = algorithms::MaximumFlowAlgorithms::EdmondsKarp(graph, source, sink);
             std::cout << "Graph with flow: " << std::endl;
-            auto opt_graph = utils::GraphUtils::GetOptimalGraph(result->getGraph(), utils::GraphUtils::GetResidualGraph(graph));
+            auto opt_graph = utils::GraphUtils::GetOptimalGraph(result->getGraph(), graph);
             std::cout << opt_graph->toString() << std::endl;
+            print_edge_flow(*utils::GraphUtils::GetEdgeFlow(opt_graph, graph));
             std::cout << "Maximum flow: " << result->getFlow() << std::endl;
+            std::cout << "Flow decomposition: " << std::endl;
+            utils::GraphUtils::DecomposeFlow(opt_graph, source, sink, print_path);
             break;
         }
         case 2:
@@ -58,32 +108,54 @@ int main(int argc, char **argv)
             std::cout << "1. Cycle-cancelling" << std::endl;
             std::cout << "2. Successive shortest path" << std::endl;
             std::cout << "3. Primal-dual" << std::endl;
-            std::cout << "4. Exit" << std::endl;
+            std::cout << "4. Convex cost successive shortest path (piecewise-linear costs)" << std::endl;
+            std::cout << "5. Exit" << std::endl;
             std::cout << "Enter your choice: ";
             std::cin >> choice;
             std::cout << std::endl;
 
+            // solve by components, on the renumbered graph if a node order was given
+            using MinimumCostFlowAlgorithm = std::function<std::shared_ptr<dto::FlowResult>(const std::shared_ptr<data_structures::Graph> &, int, int)>;
+            auto solve = [&](const MinimumCostFlowAlgorithm &algorithm)
+            {
+                MinimumCostFlowAlgorithm by_components = [&algorithm](const std::shared_ptr<data_structures::Graph> &g, int s, int t)
+                {
+                    return algorithms::MinimumCostFlowAlgorithms::SolveByComponents(g, s, t, algorithm);
+                };
+                if (!node_order)
+                {
+                    return by_components(graph, source, sink);
+                }
+                return algorithms::MinimumCostFlowAlgorithms::SolveReordered(graph, source, sink, by_components, *node_order);
+            };
+
             switch (choice)
             {
             case 1:
             {
                 std::cout << "Cycle-cancelling selected!" << std::endl;
-                result = algorithms::MinimumCostFlowAlgorithms::CycleCancelling(graph, source, sink);
+                result = solve(algorithms::MinimumCostFlowAlgorithms::CycleCancelling);
                 break;
             }
             case 2:
             {
                 std::cout << "Successive shortest path selected!" << std::endl;
-                result = algorithms::MinimumCostFlowAlgorithms::SuccessiveShortestPath(graph, source, sink);
+                result = solve(algorithms::MinimumCostFlowAlgorithms::SuccessiveShortestPath);
                 break;
             }
             case 3:
             {
                 std::cout << "Primal-dual selected!" << std::endl;
-                result = algorithms::MinimumCostFlowAlgorithms::PrimalDual(graph, source, sink);
+                result = solve(algorithms::MinimumCostFlowAlgorithms::PrimalDual);
                 break;
             }
             case 4:
+            {
+                std::cout << "Convex cost successive shortest path selected!" << std::endl;
+                result = solve(algorithms::MinimumCostFlowAlgorithms::ConvexCostFlow);
+                break;
+            }
+            case 5:
             {
                 return EXIT_SUCCESS;
                 ;
@@ -95,10 +167,40 @@ int main(int argc, char **argv)
             }
             std::cout << "Graph with flow: " << std::endl;
             std::cout << result->getGraph()->toString() << std::endl;
+            print_edge_flow(*result->getEdgeFlow());
             std::cout << "Minimum cost flow: " << result->getFlow() << std::endl;
+            std::cout << "Flow decomposition: " << std::endl;
+            utils::GraphUtils::DecomposeFlow(result->getGraph(), source, sink, print_path);
+
+            // node potentials and cost ranges for which the flow stays optimal (only for linear costs, directed edges and no node capacities)
+            if (utils::GraphUtils::HasConvexCosts(graph) || utils::GraphUtils::HasUndirectedEdges(graph) || !graph->getNodeCapacities()->empty())
+            {
+                break;
+            }
+            auto sensitivity_report = algorithms::MinimumCostFlowAlgorithms::CostSensitivity(graph, result);
+            std::cout << "Sensitivity report: " << std::endl;
+            std::cout << sensitivity_report->toString() << std::endl;
             break;
         }
         case 3:
+        {
+            int lambda_min{};
+            int lambda_max{};
+            std::cout << "Enter the minimum and the maximum lambda: ";
+            std::cin >> lambda_min >> lambda_max;
+            std::cout << std::endl;
+
+            auto parametric_result = algorithms::MaximumFlowAlgorithms::ParametricMaxFlow(graph, source, sink, lambda_min, lambda_max, false);
+            auto breakpoints = parametric_result->getBreakpoints();
+            for (unsigned i = 0; i <= breakpoints->size(); i++)
+            {
+                std::cout << "lambda in [" << (i == 0 ? lambda_min : breakpoints->at(i - 1)) << ", "
+                          << (i == breakpoints->size() ? lambda_max : breakpoints->at(i)) << "]: maximum flow = "
+                          << parametric_result->getIntercepts()->at(i) << " + lambda * " << parametric_result->getSlopes()->at(i) << std::endl;
+            }
+            break;
+        }
+        case 4:
         {
             break;
         }
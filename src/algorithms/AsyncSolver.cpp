@@ -0,0 +1,184 @@
+#include "AsyncSolver.h"
+
+#include "utils/ProgressReporter.h"
+
+#include <atomic>
+#include <utility>
+#include <stdexcept>
+
+namespace algorithms {
+    namespace {
+        /**
+         * Memory resource of a single solve: a synchronized pool (the result can be released on any thread)
+         * that deletes itself when the solve released it and every allocation was returned, so the results
+         * can outlive the solve and the solver.
+         */
+        class SolvePool : public std::pmr::memory_resource {
+            public:
+                /**
+                 * Release the pool from the solve, it is deleted now if no allocation is left, else with the last one.
+                 */
+                void release() {
+                    if (this->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        delete this;
+                    }
+                }
+
+            private:
+                void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+                    void* p { this->pool.allocate(bytes, alignment) };
+                    this->references.fetch_add(1, std::memory_order_relaxed);
+                    return p;
+                }
+
+                void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+                    this->pool.deallocate(p, bytes, alignment);
+                    this->release();
+                }
+
+                [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+                    return this == &other;
+                }
+
+                std::pmr::synchronized_pool_resource pool { std::pmr::new_delete_resource() };
+
+                // allocations not returned, plus one for the solve until it releases the pool
+                std::atomic<std::size_t> references { 1 };
+        };
+    }
+
+    SolveHandle::SolveHandle(std::shared_ptr<State> state) : state(std::move(state)) {}
+
+    bool SolveHandle::isReady() const {
+        std::lock_guard<std::mutex> lock(this->state->mutex);
+        return this->state->done;
+    }
+
+    void SolveHandle::wait() const {
+        std::unique_lock<std::mutex> lock(this->state->mutex);
+        this->state->ended.wait(lock, [this]() { return this->state->done; });
+    }
+
+    std::shared_ptr<dto::FlowResult> SolveHandle::get() const {
+        this->wait();
+        if (this->state->error) {
+            std::rethrow_exception(this->state->error);
+        }
+        return this->state->result;
+    }
+
+    bool SolveHandle::await_ready() const {
+        return this->isReady();
+    }
+
+    bool SolveHandle::await_suspend(std::coroutine_handle<> continuation) const {
+        std::lock_guard<std::mutex> lock(this->state->mutex);
+        if (this->state->done) {
+            return false;
+        }
+        this->state->continuation = continuation;
+        return true;
+    }
+
+    std::shared_ptr<dto::FlowResult> SolveHandle::await_resume() const {
+        return this->get();
+    }
+
+    AsyncSolver::AsyncSolver(int num_threads) : stopping(false) {
+        if (num_threads <= 0) {
+            throw std::invalid_argument("The number of threads must be positive");
+        }
+
+        for (int i = 0; i < num_threads; i++) {
+            this->threads.emplace_back(&AsyncSolver::run, this);
+        }
+    }
+
+    AsyncSolver::~AsyncSolver() {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->stopping = true;
+        }
+        this->submitted.notify_all();
+
+        for (auto& thread : this->threads) {
+            thread.join();
+        }
+    }
+
+    SolveHandle AsyncSolver::submit(const std::shared_ptr<data_structures::Graph>& graph, int source, int sink,
+        std::function<std::shared_ptr<dto::FlowResult>(const std::shared_ptr<data_structures::Graph>&, int, int)> algorithm,
+        std::function<void(const dto::SolveProgress&)> progress, std::pmr::memory_resource* resource) {
+
+        auto state = std::make_shared<SolveHandle::State>();
+
+        // the pool of the solve is owned by the task, it is released when the task is destroyed
+        // (and freed with the last graph allocated from it)
+        std::shared_ptr<SolvePool> pool;
+        if (!resource && !AsyncSolver::IsThreadSafe(graph->getMemoryResource())) {
+            pool = std::shared_ptr<SolvePool>(new SolvePool(), [](SolvePool* p) { p->release(); });
+            resource = pool.get();
+        }
+
+        // the copy is made on the calling thread, it shares the lists only if it is in the resource of the graph
+        std::shared_ptr<data_structures::Graph> snapshot;
+        if (!resource || resource == graph->getMemoryResource()) {
+            snapshot = std::make_shared<data_structures::Graph>(graph);
+        } else {
+            snapshot = std::make_shared<data_structures::Graph>(graph, resource);
+        }
+
+        auto solve = [state, pool, snapshot, source, sink, algorithm = std::move(algorithm), progress = std::move(progress)]() {
+            std::shared_ptr<dto::FlowResult> result;
+            std::exception_ptr error;
+            try {
+                utils::ProgressReporter reporter(progress);
+                result = algorithm(snapshot, source, sink);
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            // the waiting coroutine is resumed outside the lock, it can await another solve
+            std::coroutine_handle<> continuation;
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->result = std::move(result);
+                state->error = error;
+                state->done = true;
+                continuation = std::exchange(state->continuation, nullptr);
+            }
+            state->ended.notify_all();
+            if (continuation) {
+                continuation.resume();
+            }
+        };
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->solves.push(std::move(solve));
+        }
+        this->submitted.notify_one();
+
+        return SolveHandle(state);
+    }
+
+    bool AsyncSolver::IsThreadSafe(std::pmr::memory_resource* resource) {
+        return resource == std::pmr::new_delete_resource() || dynamic_cast<std::pmr::synchronized_pool_resource*>(resource);
+    }
+
+    void AsyncSolver::run() {
+        while (true) {
+            std::function<void()> solve;
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->submitted.wait(lock, [this]() { return this->stopping || !this->solves.empty(); });
+                if (this->solves.empty()) {
+                    return;
+                }
+                solve = std::move(this->solves.front());
+                this->solves.pop();
+            }
+            solve();
+        }
+    }
+}
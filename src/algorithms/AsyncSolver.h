@@ -0,0 +1,181 @@
+#ifndef NETWORK_FLOWS_ASYNCSOLVER_H
+#define NETWORK_FLOWS_ASYNCSOLVER_H
+
+#include "data_structures/graph/Graph.h"
+#include "dto/flowResult/FlowResult.h"
+#include "dto/solveProgress/SolveProgress.h"
+
+#include <mutex>
+#include <queue>
+#include <memory>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+namespace algorithms {
+    /**
+     * Result of a solve submitted to an AsyncSolver, available when the solve ends.
+     * It can be waited like a future (see get()) or awaited in a coroutine (co_await handle): the coroutine is
+     * resumed on the thread that ends the solve, or it does not suspend if the solve already ended.
+     * The copies of a handle refer to the same solve.
+     */
+    class SolveHandle {
+        public:
+            /**
+             * Check if the solve ended (with a result or with an error).
+             *
+             * @return true if the solve ended, false otherwise
+             */
+            [[nodiscard]] bool isReady() const;
+
+            /**
+             * Wait until the solve ends.
+             */
+            void wait() const;
+
+            /**
+             * Wait until the solve ends and get its result.
+             *
+             * @return the result of the solve
+             *
+             * @throws the exception thrown by the solve, if any
+             */
+            [[nodiscard]] std::shared_ptr<dto::FlowResult> get() const;
+
+            /**
+             * Awaitable interface (see co_await): the coroutine does not suspend if the solve already ended.
+             *
+             * @return true if the solve ended, false otherwise
+             */
+            [[nodiscard]] bool await_ready() const;
+
+            /**
+             * Awaitable interface: resume the coroutine when the solve ends.
+             *
+             * @param continuation the suspended coroutine
+             *
+             * @return false if the solve ended meanwhile (the coroutine is resumed immediately), true otherwise
+             */
+            bool await_suspend(std::coroutine_handle<> continuation) const;
+
+            /**
+             * Awaitable interface: the result of the solve (see get()).
+             *
+             * @return the result of the solve
+             *
+             * @throws the exception thrown by the solve, if any
+             */
+            std::shared_ptr<dto::FlowResult> await_resume() const;
+
+        private:
+            friend class AsyncSolver;
+
+            /**
+             * State of a solve, shared by its handles and by the thread running it.
+             */
+            struct State {
+                std::mutex mutex;
+                std::condition_variable ended;
+                bool done { false };
+                std::shared_ptr<dto::FlowResult> result;
+                std::exception_ptr error;
+
+                // coroutine waiting for the solve, resumed when it ends
+                std::coroutine_handle<> continuation;
+            };
+
+            explicit SolveHandle(std::shared_ptr<State> state);
+
+            std::shared_ptr<State> state;
+    };
+
+    /**
+     * Pool of threads running the solves submitted asynchronously, so many solves can be multiplexed on a few threads.
+     * Each solve runs on a copy of the graph taken at submission, so the caller can keep modifying its graph,
+     * and it can report its progress (see utils::ProgressReporter) to a callback called on the thread running it.
+     * The copy and the graphs of the result are allocated from the memory resource of the solve (see submit()):
+     * by default the resource of the graph if it is thread-safe (the copy is copy-on-write, O(1)), else a pool
+     * of the solve, so the threads of the solver never allocate from (or return memory to) a resource of the caller
+     * that is not thread-safe. The pool of a solve is freed when the last graph allocated from it is released.
+     * The solves are started in submission order; the destructor waits for all the submitted solves to end.
+     */
+    class AsyncSolver {
+        public:
+            /**
+             * Constructor, start the threads.
+             *
+             * @param num_threads the number of threads running the solves
+             *
+             * @throws invalid_argument if the number of threads is not positive
+             */
+            explicit AsyncSolver(int num_threads);
+
+            AsyncSolver(const AsyncSolver&) = delete;
+            AsyncSolver& operator=(const AsyncSolver&) = delete;
+
+            /**
+             * Destructor, wait for the submitted solves to end and stop the threads.
+             */
+            ~AsyncSolver();
+
+            /**
+             * Submit a solve.
+             * The graph is copied in the memory resource of the solve: with the resource of the graph the copy
+             * shares its lists (copy-on-write), with another resource the copy is deep (see Graph).
+             * The resource is used by the thread of the solve and by the threads releasing the result,
+             * so the resource of the graph or a resource shared with other solves must be thread-safe.
+             *
+             * V: number of nodes
+             * E: number of edges
+             * Time complexity: O(1) with the resource of the graph, O(V + E) otherwise (the copy of the graph,
+             *                  the solve runs on the threads of the solver)
+             *
+             * @param graph     the graph to solve (copied at submission)
+             * @param source    the source node
+             * @param sink      the sink node
+             * @param algorithm the algorithm (e.g. MinimumCostFlowAlgorithms::PrimalDual, MaximumFlowAlgorithms::EdmondsKarp)
+             * @param progress  the function called after each augmentation of the solve (optional)
+             * @param resource  the memory resource of the solve (optional, by default the resource of the graph
+             *                  if it is thread-safe, see IsThreadSafe(), else a pool of the solve)
+             *
+             * @return the handle of the result of the solve
+             */
+            SolveHandle submit(const std::shared_ptr<data_structures::Graph>& graph, int source, int sink,
+                std::function<std::shared_ptr<dto::FlowResult>(const std::shared_ptr<data_structures::Graph>&, int, int)> algorithm,
+                std::function<void(const dto::SolveProgress&)> progress = {}, std::pmr::memory_resource* resource = nullptr);
+
+            /**
+             * Check if a memory resource is known to be thread-safe: std::pmr::new_delete_resource() (the default one
+             * unless it is replaced) and the std::pmr::synchronized_pool_resource.
+             *
+             * @param resource the memory resource
+             *
+             * @return true if the resource is thread-safe, false if it is not or it is unknown
+             */
+            [[nodiscard]] static bool IsThreadSafe(std::pmr::memory_resource* resource);
+
+        private:
+            /**
+             * Run the submitted solves until the solver is destroyed and the queue is empty.
+             */
+            void run();
+
+            std::vector<std::thread> threads;
+
+            // solves not started yet
+            std::queue<std::function<void()>> solves;
+
+            // guards the queue and stopping
+            std::mutex mutex;
+            std::condition_variable submitted;
+
+            // true when the solver is destroyed
+            bool stopping;
+    };
+}
+
+#endif //NETWORK_FLOWS_ASYNCSOLVER_H
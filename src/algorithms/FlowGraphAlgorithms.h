@@ -0,0 +1,120 @@
+#ifndef NETWORK_FLOWS_FLOWGRAPHALGORITHMS_H
+#define NETWORK_FLOWS_FLOWGRAPHALGORITHMS_H
+
+#include "data_structures/flowGraph/FlowGraph.h"
+#include "utils/LargeArrays.h"
+#include "utils/ProgressReporter.h"
+
+#include <queue>
+#include <limits>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+namespace algorithms {
+    /**
+     * Class containing the flow algorithms written once for any representation of the residual network
+     * (see data_structures::FlowGraph):
+     * - BFS on the residual edges
+     * - Edmonds-Karp
+     * The algorithms are templates, so they are compiled (and inlined) for each representation.
+     */
+    class FlowGraphAlgorithms {
+        public:
+            /**
+             * Type of the capacities of a representation, also the type of the flows sent on it.
+             */
+            template<data_structures::FlowGraph G>
+            using Capacity = std::remove_cvref_t<decltype(std::declval<const G&>().getResidualCapacity(0, 0))>;
+
+            /**
+             * BFS algorithm on the residual edges with positive capacity.
+             * The search stops as soon as the sink is reached.
+             *
+             * V: number of nodes
+             * E: number of edges
+             * Time complexity: O(V + E)
+             *
+             * @param graph  the residual network
+             * @param source the source node
+             * @param sink   the sink node
+             * @param parent the parent of each node in the BFS tree (output, -1 for the source and the nodes not reached)
+             *
+             * @return true if the sink is reachable from the source, false otherwise
+             */
+            template<data_structures::FlowGraph G>
+            static bool BFS(const G& graph, int source, int sink, std::vector<int>& parent);
+
+            /**
+             * Edmonds-Karp algorithm: send flow along shortest augmenting paths until the sink is not reachable.
+             * The flow is pushed on the residual network in place, starting from its current flow.
+             *
+             * (see: https://en.wikipedia.org/wiki/Edmonds%E2%80%93Karp_algorithm)
+             *
+             * V: number of nodes
+             * E: number of edges
+             * Time complexity: O(V * E^2)
+             *
+             * @param graph  the residual network
+             * @param source the source node
+             * @param sink   the sink node
+             *
+             * @return the flow sent from source to sink (of the type of the capacities)
+             */
+            template<data_structures::FlowGraph G>
+            static Capacity<G> EdmondsKarp(G& graph, int source, int sink);
+    };
+
+    template<data_structures::FlowGraph G>
+    bool FlowGraphAlgorithms::BFS(const G& graph, int source, int sink, std::vector<int>& parent) {
+        parent.assign(graph.getNumNodes(), -1);
+        utils::LargeVector<bool> visited(graph.getNumNodes(), false);
+        visited.at(source) = true;
+
+        std::queue<int> q {};
+        q.push(source);
+
+        // the neighbors of a node are visited all together, the loop ends at the first level reaching the sink
+        while (!q.empty() && !visited.at(sink)) {
+            int node { q.front() };
+            q.pop();
+
+            graph.forEachResidualNeighbor(node, [&](int next) {
+                if (!visited[next]) {
+                    visited[next] = true;
+                    parent[next] = node;
+                    q.push(next);
+                }
+            });
+        }
+
+        return visited.at(sink) && source != sink;
+    }
+
+    template<data_structures::FlowGraph G>
+    FlowGraphAlgorithms::Capacity<G> FlowGraphAlgorithms::EdmondsKarp(G& graph, int source, int sink) {
+        Capacity<G> flow {};
+        std::vector<int> parent;
+
+        while (FlowGraphAlgorithms::BFS(graph, source, sink, parent)) {
+            // find the minimum residual capacity of the edges in the path
+            Capacity<G> path_flow { std::numeric_limits<Capacity<G>>::max() };
+            for (int v = sink; v != source; v = parent[v]) {
+                path_flow = std::min(path_flow, graph.getResidualCapacity(parent[v], v));
+            }
+
+            // update the residual capacities
+            for (int v = sink; v != source; v = parent[v]) {
+                graph.push(parent[v], v, path_flow);
+            }
+
+            flow += path_flow;
+            utils::ProgressReporter::Augment(static_cast<int>(path_flow), 0);
+        }
+
+        return flow;
+    }
+}
+
+#endif //NETWORK_FLOWS_FLOWGRAPHALGORITHMS_H
@@ -3,54 +3,16 @@
 #include "consts/Consts.h"
 #include "utils/GraphUtils.h"
 
-#include <set>
-#include <queue>
 #include <vector>
 #include <memory>
 #include <limits>
+#include <algorithm>
+#include <utility>
+#include <functional>
+#include <stdexcept>
 
 namespace algorithms
 {
-    std::shared_ptr<dto::BfsResult> GraphBaseAlgorithms::BFS(const std::shared_ptr<data_structures::Graph> &graph, int source, int sink)
-    {
-        int num_nodes{graph->getNumNodes()};
-        auto parent = std::make_shared<std::vector<int>>(num_nodes);
-
-        std::vector<bool> visited(num_nodes, false);
-        visited.at(source) = true;
-
-        std::queue<int> q{};
-        q.push(source);
-        parent->at(source) = consts::source_parent;
-
-        // Standard BFS loop, with the modification that we exit the loop as soon as we find the sink
-        while (!q.empty())
-        {
-            int current_node{q.front()};
-            q.pop();
-
-            for (auto e : *graph->getNodeAdjList(current_node))
-            {
-
-                if (!visited.at(e.getSink()))
-                {
-                    parent->at(e.getSink()) = current_node;
-
-                    if (e.getSink() == sink)
-                    {
-                        return std::make_shared<dto::BfsResult>(true, parent);
-                    }
-
-                    visited.at(e.getSink()) = true;
-                    q.push(e.getSink());
-                }
-            }
-        }
-
-        // If we reach here, then there is no path from source to sink
-        return std::make_shared<dto::BfsResult>(false, parent);
-    }
-
     std::shared_ptr<dto::BellmanFordResult> GraphBaseAlgorithms::BellmanFord(const std::shared_ptr<data_structures::Graph> &graph, int source)
     {
         int num_nodes{graph->getNumNodes()};
@@ -61,8 +23,8 @@ namespace algorithms
         // Initialize the distance array to infinity and the parent array to -1
         for (int i = 0; i < num_nodes; i++)
         {
-            dist->at(i) = std::numeric_limits<int>::max();
-            parent->at(i) = -1;
+            (*dist)[i] = std::numeric_limits<int>::max();
+            (*parent)[i] = -1;
         }
         dist->at(source) = 0;
 
@@ -71,16 +33,16 @@ namespace algorithms
         {
             for (int node = 0; node < num_nodes; node++)
             {
-                for (auto e : *graph->getNodeAdjList(node))
+                for (const auto& e : graph->getNodeAdjListUnchecked(node))
                 {
                     int sink{e.getSink()};
                     int cost{e.getCost()};
 
                     // Update dist[v] if dist[u] + weight < dist[v]
-                    if (dist->at(node) != std::numeric_limits<int>::max() && dist->at(node) + cost < dist->at(sink))
+                    if ((*dist)[node] != std::numeric_limits<int>::max() && (*dist)[node] + cost < (*dist)[sink])
                     {
-                        dist->at(sink) = dist->at(node) + cost;
-                        parent->at(sink) = node;
+                        (*dist)[sink] = (*dist)[node] + cost;
+                        (*parent)[sink] = node;
                     }
                 }
             }
@@ -89,18 +51,25 @@ namespace algorithms
         // Check for negative-cost cycles
         for (int node = 0; node < num_nodes; node++)
         {
-            for (auto e : *graph->getNodeAdjList(node))
+            for (const auto& e : graph->getNodeAdjListUnchecked(node))
             {
                 int sink{e.getSink()};
                 int cost{e.getCost()};
 
                 // Found a negative-weight cycle, get the cycle and return it
-                if (dist->at(node) != std::numeric_limits<int>::max() && dist->at(node) + cost < dist->at(sink))
+                if ((*dist)[node] != std::numeric_limits<int>::max() && (*dist)[node] + cost < (*dist)[sink])
                 {
 
+                    // Walk back |V| times along the parents to be sure to be inside the cycle
+                    int node_in_cycle{sink};
+                    for (int j = 0; j < num_nodes; j++)
+                    {
+                        node_in_cycle = (*parent)[node_in_cycle];
+                    }
+
                     // Result in case a negative-weight cycle was found
-                    // It contains the negative-weight cycle
-                    return std::make_shared<dto::BellmanFordResult>(utils::GraphUtils::RetrievePath(parent, consts::source_parent, sink));
+                    // It contains the negative-weight cycle (first and last node are the same)
+                    return std::make_shared<dto::BellmanFordResult>(utils::GraphUtils::RetrievePath(parent, node_in_cycle, node_in_cycle));
                 }
             }
         }
@@ -110,66 +79,307 @@ namespace algorithms
         return std::make_shared<dto::BellmanFordResult>(dist, parent);
     }
 
-    std::shared_ptr<dto::DijkstraResult> GraphBaseAlgorithms::Dijkstra(const std::shared_ptr<data_structures::Graph> &graph, int source)
+    std::shared_ptr<std::vector<int>> GraphBaseAlgorithms::WeaklyConnectedComponents(const std::shared_ptr<data_structures::Graph> &graph)
     {
         int num_nodes{graph->getNumNodes()};
 
-        auto dist = std::make_shared<std::vector<int>>(num_nodes);
-        auto parent = std::make_shared<std::vector<int>>(num_nodes);
-        std::vector<int> q{};    // q contains all the nodes that have not been visited yet
-        std::set<int> visited{}; // visited contains all the nodes that have been visited
+        // union-find: parent and size of each set
+        std::vector<int> parent(num_nodes);
+        std::vector<int> size(num_nodes, 1);
+        for (int u = 0; u < num_nodes; u++)
+        {
+            parent.at(u) = u;
+        }
 
-        // Initialize the distance array to infinity and the parent array to -1
+        auto find = [&parent](int u)
+        {
+            while (parent.at(u) != u)
+            {
+                // path compression (halving)
+                parent.at(u) = parent.at(parent.at(u));
+                u = parent.at(u);
+            }
+            return u;
+        };
+
+        for (int u = 0; u < num_nodes; u++)
+        {
+            for (auto e : *graph->getNodeAdjList(u))
+            {
+                int a{find(u)};
+                int b{find(e.getSink())};
+                if (a == b)
+                {
+                    continue;
+                }
+
+                // union by size
+                if (size.at(a) < size.at(b))
+                {
+                    std::swap(a, b);
+                }
+                parent.at(b) = a;
+                size.at(a) += size.at(b);
+            }
+        }
+
+        // number the components in order of their smallest node
+        auto component = std::make_shared<std::vector<int>>(num_nodes, -1);
+        std::vector<int> root_component(num_nodes, -1);
+        int num_components{};
+        for (int u = 0; u < num_nodes; u++)
+        {
+            int root{find(u)};
+            if (root_component.at(root) == -1)
+            {
+                root_component.at(root) = num_components++;
+            }
+            component->at(u) = root_component.at(root);
+        }
+
+        return component;
+    }
+
+    std::shared_ptr<std::vector<std::vector<int>>> GraphBaseAlgorithms::StronglyConnectedComponents(const std::shared_ptr<data_structures::Graph> &graph)
+    {
+        std::vector<int> nodes(graph->getNumNodes());
+        for (int u = 0; u < graph->getNumNodes(); u++)
+        {
+            nodes.at(u) = u;
+        }
+
+        return GraphBaseAlgorithms::StronglyConnectedComponents(graph, nodes);
+    }
+
+    std::shared_ptr<std::vector<std::vector<int>>> GraphBaseAlgorithms::StronglyConnectedComponents(const std::shared_ptr<data_structures::Graph> &graph,
+                                                                                                  const std::vector<int> &nodes)
+    {
+        auto components = std::make_shared<std::vector<std::vector<int>>>();
+        int num_nodes{static_cast<int>(nodes.size())};
+
+        // index of each node in the subgraph, -1 for the nodes outside
+        std::vector<int> local(graph->getNumNodes(), -1);
         for (int i = 0; i < num_nodes; i++)
         {
-            dist->at(i) = std::numeric_limits<int>::max();
-            parent->at(i) = -1;
-            q.push_back(i);
+            local.at(nodes.at(i)) = i;
         }
 
-        // Set source distance and parent
-        dist->at(source) = 0;
-        parent->at(source) = consts::source_parent;
+        std::vector<int> order(num_nodes, -1); // visit order of each node, -1 if not visited
+        std::vector<int> low(num_nodes);       // lowest visit order reachable from the subtree of the node
+        std::vector<bool> on_stack(num_nodes, false);
+        std::vector<int> stack{};
+        int visit_order{};
+
+        // explicit DFS stack: (node, index of the next edge to visit)
+        std::vector<std::pair<int, unsigned>> dfs{};
+
+        for (int root = 0; root < num_nodes; root++)
+        {
+            if (order.at(root) != -1)
+            {
+                continue;
+            }
+
+            dfs.emplace_back(root, 0);
+            order.at(root) = low.at(root) = visit_order++;
+            stack.push_back(root);
+            on_stack.at(root) = true;
+
+            while (!dfs.empty())
+            {
+                auto &[u, next_edge] = dfs.back();
+                auto adj_list = graph->getNodeAdjList(nodes.at(u));
+
+                if (next_edge < adj_list->size())
+                {
+                    int v{local.at(adj_list->at(next_edge++).getSink())};
+                    if (v == -1)
+                    {
+                        continue;
+                    }
+
+                    if (order.at(v) == -1)
+                    {
+                        order.at(v) = low.at(v) = visit_order++;
+                        stack.push_back(v);
+                        on_stack.at(v) = true;
+                        dfs.emplace_back(v, 0);
+                    }
+                    else if (on_stack.at(v))
+                    {
+                        low.at(u) = std::min(low.at(u), order.at(v));
+                    }
+                    continue;
+                }
+
+                // all the edges of u are visited, if u is the root of a component pop it from the stack
+                int node{u};
+                dfs.pop_back();
+                if (!dfs.empty())
+                {
+                    low.at(dfs.back().first) = std::min(low.at(dfs.back().first), low.at(node));
+                }
 
-        while (!q.empty())
+                if (low.at(node) == order.at(node))
+                {
+                    std::vector<int> component{};
+                    int v{};
+                    do
+                    {
+                        v = stack.back();
+                        stack.pop_back();
+                        on_stack.at(v) = false;
+                        component.push_back(nodes.at(v));
+                    } while (v != node);
+                    components->push_back(component);
+                }
+            }
+        }
+
+        return components;
+    }
+
+    std::shared_ptr<dto::BellmanFordResult> GraphBaseAlgorithms::FindNegativeCycle(const std::shared_ptr<data_structures::Graph> &graph,
+                                                                                   const std::vector<int> &nodes)
+    {
+        int num_nodes{graph->getNumNodes()};
+
+        std::vector<bool> in_subgraph(num_nodes, false);
+        for (int u : nodes)
         {
+            in_subgraph.at(u) = true;
+        }
 
-            // Find the node with the minimum distance
-            int min_dist{std::numeric_limits<int>::max()};
-            int current_node{-1};  // node
-            int current_index{-1}; // node index
-            for (unsigned i = 0; i < q.size(); i++)
+        // all the nodes start at distance 0 (virtual source connected to every node)
+        auto dist = std::make_shared<std::vector<int>>(num_nodes, 0);
+        auto parent = std::make_shared<std::vector<int>>(num_nodes, -1);
+
+        // with the virtual source the shortest paths have at most |nodes| edges,
+        // so a change in the pass number |nodes| + 1 means there is a negative cycle
+        int last_updated{-1};
+        for (int i = 0; i <= static_cast<int>(nodes.size()); i++)
+        {
+            last_updated = -1;
+            for (int node : nodes)
             {
-                int node{q.at(i)};
-                if (dist->at(node) < min_dist)
+                for (auto e : *graph->getNodeAdjList(node))
                 {
-                    min_dist = dist->at(node);
-                    current_node = node;
-                    current_index = i;
+                    int sink{e.getSink()};
+                    if (in_subgraph.at(sink) && dist->at(node) + e.getCost() < dist->at(sink))
+                    {
+                        dist->at(sink) = dist->at(node) + e.getCost();
+                        parent->at(sink) = node;
+                        last_updated = sink;
+                    }
                 }
             }
 
-            // remove the node from the queue
-            q.erase(q.begin() + current_index);
+            // no distance changed, the distances are final
+            if (last_updated == -1)
+            {
+                return std::make_shared<dto::BellmanFordResult>(dist, parent);
+            }
+        }
 
-            // Mark the node as visited
-            visited.insert(current_node);
+        // Walk back |nodes| times along the parents to be sure to be inside the cycle
+        int node_in_cycle{last_updated};
+        for (unsigned j = 0; j < nodes.size(); j++)
+        {
+            node_in_cycle = parent->at(node_in_cycle);
+        }
+
+        // It contains the negative-weight cycle (first and last node are the same)
+        return std::make_shared<dto::BellmanFordResult>(utils::GraphUtils::RetrievePath(parent, node_in_cycle, node_in_cycle));
+    }
 
-            // Relax all edges going out of the current node
-            for (auto e : *graph->getNodeAdjList(current_node))
+    std::shared_ptr<std::vector<int>> GraphBaseAlgorithms::NodeOrdering(const std::shared_ptr<data_structures::Graph> &graph, int source, NodeOrder order)
+    {
+        int num_nodes{graph->getNumNodes()};
+        if (source < 0 || source >= num_nodes)
+        {
+            throw std::invalid_argument("The source must be a node of the graph");
+        }
+
+        // neighbors of each node ignoring the direction of the edges
+        std::vector<std::vector<int>> neighbors(num_nodes);
+        for (int u = 0; u < num_nodes; u++)
+        {
+            for (const auto &e : *graph->getNodeAdjList(u))
             {
-                int sink{e.getSink()};
-                int cost{e.getCost()};
+                neighbors.at(u).push_back(e.getSink());
+                neighbors.at(e.getSink()).push_back(u);
+            }
+        }
+
+        auto nodes = std::make_shared<std::vector<int>>();
+        nodes->reserve(num_nodes);
+
+        if (order == NodeOrder::Degree)
+        {
+            for (int u = 0; u < num_nodes; u++)
+            {
+                nodes->push_back(u);
+            }
+            std::stable_sort(nodes->begin(), nodes->end(), [&neighbors](int u, int v) {
+                return neighbors.at(u).size() > neighbors.at(v).size();
+            });
+            return nodes;
+        }
+
+        // Cuthill-McKee visits the neighbors by increasing degree
+        bool by_degree{order == NodeOrder::ReverseCuthillMcKee};
+        if (by_degree)
+        {
+            for (auto &adj : neighbors)
+            {
+                std::stable_sort(adj.begin(), adj.end(), [&neighbors](int u, int v) {
+                    return neighbors.at(u).size() < neighbors.at(v).size();
+                });
+            }
+        }
+
+        // the starting nodes of the components: the source first, then the nodes by id (or by increasing degree)
+        std::vector<int> starts{source};
+        for (int u = 0; u < num_nodes; u++)
+        {
+            starts.push_back(u);
+        }
+        if (by_degree)
+        {
+            std::stable_sort(starts.begin(), starts.end(), [&neighbors](int u, int v) {
+                return neighbors.at(u).size() < neighbors.at(v).size();
+            });
+        }
+
+        // the queue of the BFS is the order itself
+        std::vector<bool> visited(num_nodes, false);
+        for (int start : starts)
+        {
+            if (visited.at(start))
+            {
+                continue;
+            }
+            visited.at(start) = true;
+            nodes->push_back(start);
 
-                // Update dist[v] if dist[u] + weight < dist[v]
-                if (dist->at(current_node) != std::numeric_limits<int>::max() && dist->at(current_node) + cost < dist->at(sink))
+            for (unsigned i = nodes->size() - 1; i < nodes->size(); i++)
+            {
+                for (int v : neighbors.at(nodes->at(i)))
                 {
-                    dist->at(sink) = dist->at(current_node) + cost;
-                    parent->at(sink) = current_node;
+                    if (!visited.at(v))
+                    {
+                        visited.at(v) = true;
+                        nodes->push_back(v);
+                    }
                 }
             }
         }
 
-        return std::make_shared<dto::DijkstraResult>(dist, parent);
+        if (by_degree)
+        {
+            std::reverse(nodes->begin(), nodes->end());
+        }
+
+        return nodes;
     }
 }
@@ -3,15 +3,42 @@
 
 #include "dto/bfsResult/BfsResult.h"
 #include "data_structures/graph/Graph.h"
+#include "data_structures/traversalGraph/TraversalGraph.h"
 #include "dto/dijkstra/DijkstraResult.h"
 #include "dto/bellmanFord/BellmanFordResult.h"
 
+#include "consts/Consts.h"
+#include "utils/LargeArrays.h"
+
+#include <queue>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <functional>
+
 namespace algorithms {
+    /**
+     * Orders of the nodes used to renumber a graph for locality (see GraphBaseAlgorithms::NodeOrdering()):
+     * - Bfs -> breadth-first order from the source, the nodes of a level and their neighbors get close ids.
+     * - ReverseCuthillMcKee -> breadth-first order visiting the neighbors by increasing degree, reversed
+     *                          (it reduces the bandwidth of the adjacency matrix).
+     * - Degree -> nodes sorted by decreasing degree, the most visited nodes get the first ids.
+     */
+    enum class NodeOrder { Bfs, ReverseCuthillMcKee, Degree };
+
     /**
      * Class containing the following graph base algorithms:
      * - BFS (Breadth-first search) -> used to find the path from source to sink.
      * - Bellman-Ford -> used to get the shortest path from source to any other node,
      *                   also it is used to detect negative cycles.
+     * - Dijkstra -> used to get the shortest path with non-negative (reduced) costs.
+     * - Weakly connected components -> used to split the graph into independent subproblems.
+     * - Strongly connected components -> used to restrict the negative cycles search.
+     * - Node ordering -> used to renumber the nodes so that the neighbors have close ids.
+     * The source is checked, then BFS, Bellman-Ford and Dijkstra read the adjacent lists and their arrays
+     * without checks in the inner loops (see Graph::getNodeAdjListUnchecked()).
+     * BFS and Dijkstra are templates over the representation of the graph (see data_structures::TraversalGraph).
      */
     class GraphBaseAlgorithms {
     public:
@@ -21,6 +48,8 @@ namespace algorithms {
          * or searching tree or graph data structures.
          * Return true if there is a path from source to sink, false otherwise.
          * Also it fills the parent array with the path from source to sink.
+         * It is a template over the representation of the graph (see data_structures::TraversalGraph):
+         * the arcs are read from the adjacency lists or decoded from the compressed adjacency while they are visited.
          *
          * (see: https://en.wikipedia.org/wiki/Breadth-first_search)
          * 
@@ -28,14 +57,14 @@ namespace algorithms {
          * E: number of edges
          * Time complexity: O(V + E)
          *
-         * @param graph  the graph to solve
+         * @param graph  the graph to solve (e.g. *graph for a shared pointer to a Graph, or a CompressedGraph)
          * @param source the source node
-         * @param sink   the sink node
-         * @param parent the parent of each node (used to reconstruct the path)
+         * @param sink   the sink node (a node not in the graph, e.g. -1, visits every node reachable from the source)
          * 
-         * @return true if there is a path from source to sink, false otherwise
+         * @return true if there is a path from source to sink, false otherwise, and the parent of each node
          */
-        static std::shared_ptr<dto::BfsResult> BFS(const std::shared_ptr<data_structures::Graph>& graph, int source, int sink);
+        template<data_structures::TraversalGraph G>
+        static std::shared_ptr<dto::BfsResult> BFS(const G& graph, int source, int sink);
 
         /**
          * Bellman-Ford algorithm used to detect negative cycles.
@@ -60,21 +89,190 @@ namespace algorithms {
          * Dijkstra algorithm.
          * Dijkstra's algorithm is an algorithm for finding the shortest paths between nodes in a graph.
          * Return the the distance from source to every other node and the parent array.
+         * The nearest node is taken from a binary heap, the entries with an old distance are skipped.
+         * It is a template over the representation of the graph (see data_structures::TraversalGraph).
          *
-         * (see: https://en.wikipedia.org/wiki/Dijkstra%27s_algorithm)
+         * (see: https://en.wikipedia.org/wiki/Dijkstra%27s_algorithm#Using_a_priority_queue)
          *
          * V: number of nodes
          * E: number of edges
-         * Time complexity: O(V^2)
-         * (It is possible to improve the time complexity to O(E + V * log(V)) using a Fibonacci heap min-priority queue
+         * Time complexity: O((V + E) * log(V))
          * 
-         * @param graph  the graph to solve
+         * @param graph  the graph to solve (e.g. *graph for a shared pointer to a Graph, or a CompressedGraph)
          * @param source the source node
          * 
          * @return the result of the algorithm (see DijkstraResult.h)
          */
-        static std::shared_ptr<dto::DijkstraResult> Dijkstra(const std::shared_ptr<data_structures::Graph>& graph, int source);
+        template<data_structures::TraversalGraph G>
+        static std::shared_ptr<dto::DijkstraResult> Dijkstra(const G& graph, int source);
+
+        /**
+         * Weakly connected components.
+         * Two nodes are in the same weakly connected component if they are connected ignoring the direction
+         * of the edges. The components are found with a union-find (disjoint-set) structure
+         * with path compression and union by size.
+         * The components are numbered by their smallest node, so the component of node 0 is 0.
+         *
+         * (see: https://en.wikipedia.org/wiki/Disjoint-set_data_structure)
+         *
+         * V: number of nodes
+         * E: number of edges
+         * Time complexity: O(V + E * α(V)) (α: inverse Ackermann function)
+         *
+         * @param graph the graph
+         *
+         * @return the component of each node
+         */
+        static std::shared_ptr<std::vector<int>> WeaklyConnectedComponents(const std::shared_ptr<data_structures::Graph>& graph);
+
+        /**
+         * Strongly connected components (Tarjan's algorithm, iterative).
+         * Two nodes are in the same strongly connected component if each one can be reached from the other.
+         * A cycle is always contained in a strongly connected component.
+         *
+         * (see: https://en.wikipedia.org/wiki/Tarjan%27s_strongly_connected_components_algorithm)
+         *
+         * V: number of nodes
+         * E: number of edges
+         * Time complexity: O(V + E)
+         *
+         * @param graph the graph
+         *
+         * @return the nodes of each strongly connected component
+         */
+        static std::shared_ptr<std::vector<std::vector<int>>> StronglyConnectedComponents(const std::shared_ptr<data_structures::Graph>& graph);
+
+        /**
+         * Strongly connected components of the subgraph induced by the given nodes (only the edges between them are used).
+         * Used to update the components after removing edges from one of them, since removing edges can only split it.
+         *
+         * V: number of nodes of the subgraph
+         * E: number of edges leaving the nodes of the subgraph
+         * Time complexity: O(V + E) (plus O(|nodes of the graph|) to mark the nodes of the subgraph)
+         *
+         * @param graph the graph
+         * @param nodes the nodes of the subgraph
+         *
+         * @return the nodes of each strongly connected component of the subgraph
+         */
+        static std::shared_ptr<std::vector<std::vector<int>>> StronglyConnectedComponents(const std::shared_ptr<data_structures::Graph>& graph,
+                                                                                         const std::vector<int>& nodes);
+
+        /**
+         * Bellman-Ford negative cycle search restricted to the subgraph induced by the given nodes
+         * (e.g. a strongly connected component). All the nodes start at distance 0, as if they were connected to
+         * a virtual source, so every negative cycle of the subgraph is found, reachable or not from a given node.
+         * The relaxation stops as soon as a pass does not change any distance.
+         *
+         * (see https://en.wikipedia.org/wiki/Bellman%E2%80%93Ford_algorithm)
+         *
+         * V: number of nodes of the subgraph
+         * E: number of edges leaving the nodes of the subgraph
+         * Time complexity: O(V * E)
+         *
+         * @param graph the graph
+         * @param nodes the nodes of the subgraph
+         *
+         * @return the negative cycle if there is one, else the distances (from the virtual source) and the parents
+         */
+        static std::shared_ptr<dto::BellmanFordResult> FindNegativeCycle(const std::shared_ptr<data_structures::Graph>& graph,
+                                                                         const std::vector<int>& nodes);
+
+        /**
+         * Order of the nodes for a cache-friendly renumbering (see NodeOrder).
+         * The direction of the edges is ignored. The breadth-first orders start from the source
+         * (Reverse Cuthill-McKee from a node of minimum degree of each component) and continue
+         * from the first node not visited yet, so every node is in the order once.
+         * Renumbering the node order->at(i) as i (see GraphUtils::GetRenumberedGraph()) puts the data
+         * of adjacent nodes (distances, parents, adjacent lists) close in memory.
+         *
+         * (see: https://en.wikipedia.org/wiki/Cuthill%E2%80%93McKee_algorithm)
+         *
+         * V: number of nodes
+         * E: number of edges
+         * Time complexity: O(V + E * log(V))
+         *
+         * @param graph  the graph
+         * @param source the source node
+         * @param order  the order to use
+         *
+         * @return the nodes in the new order
+         */
+        static std::shared_ptr<std::vector<int>> NodeOrdering(const std::shared_ptr<data_structures::Graph>& graph, int source, NodeOrder order);
     };
+
+    template<data_structures::TraversalGraph G>
+    std::shared_ptr<dto::BfsResult> GraphBaseAlgorithms::BFS(const G& graph, int source, int sink)
+    {
+        int num_nodes{graph.getNumNodes()};
+        auto parent = std::make_shared<std::vector<int>>(num_nodes, -1);
+
+        utils::LargeVector<bool> visited(num_nodes, false);
+        visited.at(source) = true;
+        parent->at(source) = consts::source_parent;
+
+        // the queue of the BFS is a vector with a head index, the visited nodes are never removed
+        utils::LargeVector<int> q{source};
+        for (std::size_t head = 0; head < q.size(); head++)
+        {
+            int current_node{q[head]};
+            bool found{false};
+            graph.forEachArc(current_node, [&](int next, int, int) {
+                if (found || visited[next])
+                {
+                    return;
+                }
+                visited[next] = true;
+                (*parent)[next] = current_node;
+                q.push_back(next);
+                found = next == sink;
+            });
+
+            // exit the loop as soon as we find the sink
+            if (found)
+            {
+                return std::make_shared<dto::BfsResult>(true, parent);
+            }
+        }
+
+        // If we reach here, then there is no path from source to sink
+        return std::make_shared<dto::BfsResult>(false, parent);
+    }
+
+    template<data_structures::TraversalGraph G>
+    std::shared_ptr<dto::DijkstraResult> GraphBaseAlgorithms::Dijkstra(const G& graph, int source)
+    {
+        int num_nodes{graph.getNumNodes()};
+        auto dist = std::make_shared<std::vector<int>>(num_nodes, std::numeric_limits<int>::max());
+        auto parent = std::make_shared<std::vector<int>>(num_nodes, -1);
+        dist->at(source) = 0;
+        parent->at(source) = consts::source_parent;
+
+        // (distance, node), the entries with an old distance are skipped when popped
+        std::priority_queue<std::pair<int, int>, utils::LargeVector<std::pair<int, int>>, std::greater<>> q{};
+        q.emplace(0, source);
+        while (!q.empty())
+        {
+            auto [distance, current_node] = q.top();
+            q.pop();
+            if (distance != (*dist)[current_node])
+            {
+                continue;
+            }
+
+            // Update dist[v] if dist[u] + weight < dist[v]
+            graph.forEachArc(current_node, [&](int sink, int, int cost) {
+                if (distance + cost < (*dist)[sink])
+                {
+                    (*dist)[sink] = distance + cost;
+                    (*parent)[sink] = current_node;
+                    q.emplace(distance + cost, sink);
+                }
+            });
+        }
+
+        return std::make_shared<dto::DijkstraResult>(dist, parent);
+    }
 }
 
 #endif //MINIMUM_COST_FLOWS_PROBLEM_GRAPHBASEALGORITHMS_H
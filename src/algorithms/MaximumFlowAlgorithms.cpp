@@ -1,42 +1,561 @@
 #include "MaximumFlowAlgorithms.h"
 
 #include "utils/GraphUtils.h"
+#include "utils/ProgressReporter.h"
 #include "consts/Consts.h"
 #include "GraphBaseAlgorithms.h"
+#include "FlowGraphAlgorithms.h"
+#include "data_structures/flowGraph/ResidualGraphView.h"
+#include "data_structures/flowGraph/WideResidualGraph.h"
+#include "data_structures/smallGraph/SmallGraph.h"
+#include "data_structures/denseGraph/DenseGraph.h"
 
+#include <queue>
+#include <tuple>
+#include <limits>
 #include <memory>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
 
 namespace algorithms {
      std::shared_ptr<dto::FlowResult> MaximumFlowAlgorithms::EdmondsKarp(const std::shared_ptr<data_structures::Graph>& graph, int source, int sink) {
-        int max_flow {};
+        // tiny graphs are solved on the fixed-size matrix, dense graphs on the dense matrices
+        if (data_structures::SmallGraph::IsSupported(graph)) {
+            data_structures::SmallGraph small_graph(graph);
+            int max_flow { small_graph.maxFlow(source, sink) };
+            utils::ProgressReporter::Augment(max_flow, 0);
+            return MaximumFlowAlgorithms::getMatrixFlowResult(graph, max_flow, [&small_graph](int u, int v) {
+                return small_graph.getFlow(u, v);
+            });
+        }
+        if (data_structures::DenseGraph::IsSupported(graph)) {
+            data_structures::DenseGraph dense_graph(graph);
+            int max_flow { dense_graph.maxFlow(source, sink) };
+            utils::ProgressReporter::Augment(max_flow, 0);
+            return MaximumFlowAlgorithms::getMatrixFlowResult(graph, max_flow, [&dense_graph](int u, int v) {
+                return dense_graph.getFlow(u, v);
+            });
+        }
+
+        // the residual graph with the feasible flow (if there are no lower bounds the flow is 0)
+        NodeCapacities node_capacities;
+        auto feasible_flow_result = MaximumFlowAlgorithms::feasibleFlow(graph, source, sink, node_capacities);
+        auto residual_graph = feasible_flow_result->getGraph();
+
+        // augment the feasible flow up to the max flow
+        int max_flow { feasible_flow_result->getFlow() };
+        if (max_flow) {
+            utils::ProgressReporter::Augment(max_flow, 0);
+        }
+        max_flow += MaximumFlowAlgorithms::augmentShortestPaths(residual_graph, source, sink, node_capacities);
+
+        // Build the result with residual graph and max flow
+        return std::make_shared<dto::FlowResult>(residual_graph, max_flow);
+    }
+
+    std::shared_ptr<dto::FlowResult> MaximumFlowAlgorithms::getMatrixFlowResult(const std::shared_ptr<data_structures::Graph>& graph, int max_flow,
+        const std::function<int(int, int)>& pair_flow) {
+        // the residual graph has the same structure (and the same edge ids) of the one of the general algorithm
+        // (see GraphUtils::GetResidualGraph() and GraphUtils::SendFlowInPathNegativeCosts()), but it is built
+        // directly with the flow of each edge: the saturated edges are not added, the backward edges are added
+        // after all the other edges
+        int num_nodes { graph->getNumNodes() };
+        auto residual_graph = std::make_shared<data_structures::Graph>(num_nodes, false, graph->getMemoryResource());
+        int next_edge_id {};
+        int next_artificial_node { num_nodes };
+        std::vector<data_structures::Edge> backward_edges;
+        auto add_edge = [&residual_graph, &next_edge_id](int source, int sink, int capacity, int cost) {
+            data_structures::Edge edge(source, sink, capacity, cost);
+            edge.setId(next_edge_id++);
+            if (capacity) {
+                residual_graph->addEdge(edge);
+            }
+        };
+
+        // the net flow of each pair of nodes is assigned to their edges (by id), filling them in order
+        auto edge_flow = std::make_shared<std::vector<int>>(graph->getNumEdgeIds(), 0);
+        std::vector<int> flow_left(num_nodes, 0);
+        std::vector<bool> has_edge(num_nodes, false);
+        for (int u = 0; u < num_nodes; u++) {
+            for (int v = 0; v < num_nodes; v++) {
+                flow_left[v] = std::max(pair_flow(u, v), 0);
+                has_edge[v] = false;
+            }
+
+            for (const auto& e : graph->getNodeAdjListUnchecked(u)) {
+                int v { e.getSink() };
+                int capacity { e.getCapacity() };
+                if (capacity <= 0) {
+                    continue;
+                }
+                int flow { std::min(flow_left[v], capacity) };
+                flow_left[v] -= flow;
+                edge_flow->at(e.getId()) = flow;
 
+                // the anti-parallel and the parallel edges are split by an artificial node
+                if ((u < v && graph->hasEdge(v, u)) || has_edge[v]) {
+                    int artificial_node { next_artificial_node++ };
+                    add_edge(u, artificial_node, capacity - flow, e.getCost());
+                    add_edge(artificial_node, v, capacity - flow, 0);
+                    residual_graph->addArtificialNodes(artificial_node, e);
+                    if (flow) {
+                        backward_edges.emplace_back(artificial_node, u, flow, -e.getCost());
+                        backward_edges.emplace_back(v, artificial_node, flow, 0);
+                    }
+                } else {
+                    has_edge[v] = true;
+                    add_edge(u, v, capacity - flow, e.getCost());
+                    if (flow) {
+                        backward_edges.emplace_back(v, u, flow, -e.getCost());
+                    }
+                }
+            }
+        }
+
+        for (const auto& e : backward_edges) {
+            add_edge(e.getSource(), e.getSink(), e.getCapacity(), e.getCost());
+        }
+
+        return std::make_shared<dto::FlowResult>(residual_graph, max_flow, edge_flow);
+    }
+
+    std::shared_ptr<dto::FlowResult> MaximumFlowAlgorithms::FeasibleFlow(const std::shared_ptr<data_structures::Graph>& graph, int source, int sink) {
+        NodeCapacities node_capacities;
+        return MaximumFlowAlgorithms::feasibleFlow(graph, source, sink, node_capacities);
+    }
+
+    std::shared_ptr<dto::FlowResult> MaximumFlowAlgorithms::feasibleFlow(const std::shared_ptr<data_structures::Graph>& graph, int source, int sink,
+        NodeCapacities& node_capacities) {
         // the residual graph (if needed anti-parallel edges are removed using artificial nodes)
         auto residual_graph = utils::GraphUtils::GetResidualGraph(graph);
 
-        auto bfs_result = GraphBaseAlgorithms::BFS(residual_graph, source, sink);
+        // imbalances left by the lower bounds
+        auto imbalance = utils::GraphUtils::GetLowerBoundsImbalance(graph);
+
+        // the edges of the new residual graph follow the original edges
+        node_capacities.capacity = { graph->getNodeCapacities()->begin(), graph->getNodeCapacities()->end() };
+        if (!node_capacities.capacity.empty()) {
+            // artificial node of each split edge (by edge id)
+            std::map<int, int> split_edges;
+            for (auto& it : *residual_graph->getArtificialNodesMap()) {
+                split_edges.insert({ it.second.getId(), it.first });
+            }
+
+            std::vector<int> lower_bounds_inflow(graph->getNumNodes(), 0);
+            for (int u = 0; u < graph->getNumNodes(); u++) {
+                for (auto e : *graph->getNodeAdjList(u)) {
+                    lower_bounds_inflow.at(e.getSink()) += e.getLowerBound();
+                    if (!e.isUndirected() || e.getCapacity() <= 0) {
+                        continue;
+                    }
+
+                    // the pairs of residual edges of an undirected edge (two pairs if it is split by an artificial node)
+                    auto split_edge = split_edges.find(e.getId());
+                    int middle { split_edge != split_edges.end() ? split_edge->second : e.getSink() };
+                    for (auto [x, y] : { std::pair<int, int>{ u, middle }, std::pair<int, int>{ middle, e.getSink() } }) {
+                        if (x != y && (residual_graph->hasNodeCapacity(x) || residual_graph->hasNodeCapacity(y))) {
+                            node_capacities.undirected_flow.insert({ { x, y }, 0 });
+                            node_capacities.undirected_flow.insert({ { y, x }, 0 });
+                        }
+                    }
+                }
+            }
+            for (auto& [node, capacity] : node_capacities.capacity) {
+                if (lower_bounds_inflow.at(node) > capacity) {
+                    throw std::invalid_argument("There is no flow satisfying the lower bounds of the edges");
+                }
+            }
+
+            for (int u = 0; u < residual_graph->getNumNodes(); u++) {
+                for (auto e : *residual_graph->getNodeAdjList(u)) {
+                    if ((graph->hasNodeCapacity(u) || graph->hasNodeCapacity(e.getSink()))
+                        && node_capacities.undirected_flow.find({ u, e.getSink() }) == node_capacities.undirected_flow.end()) {
+                        node_capacities.forward_edges.insert({ u, e.getSink() });
+                    }
+                }
+            }
+        }
+
+        int total_excess {};
+        for (int excess : *imbalance) {
+            if (excess > 0) {
+                total_excess += excess;
+            }
+        }
+
+        // no lower bound to satisfy, the zero flow is feasible
+        if (!total_excess) {
+            return std::make_shared<dto::FlowResult>(residual_graph, 0);
+        }
+
+        int num_nodes { residual_graph->getNumNodes() };
+        int super_source { num_nodes };
+        int super_sink { num_nodes + 1 };
+        int auxiliary_node { num_nodes + 2 };
+
+        // the excess of a node already went through it (it reaches the exit of the node),
+        // the deficit has to go through it (it leaves from the exit of the node)
+        for (int node = 0; node < static_cast<int>(imbalance->size()); node++) {
+            if (imbalance->at(node) > 0) {
+                residual_graph->addEdge(super_source, node, imbalance->at(node), 0);
+            } else if (imbalance->at(node) < 0) {
+                residual_graph->addEdge(node, super_sink, -imbalance->at(node), 0);
+                node_capacities.forward_edges.insert({ node, super_sink });
+            }
+        }
+
+        // sink -> source edge (split by the auxiliary node to avoid anti-parallel edges),
+        // the flow on it can never exceed the total excess
+        residual_graph->addEdge(sink, auxiliary_node, total_excess, 0);
+        residual_graph->addEdge(auxiliary_node, source, total_excess, 0);
+        node_capacities.forward_edges.insert({ sink, auxiliary_node });
+        node_capacities.forward_edges.insert({ auxiliary_node, source });
+
+        // single max flow pass, the lower bounds are feasible only if all the excess is routed
+        // (the flow from the super source is not reported as progress, only the flow that reaches the sink is)
+        int routed_excess {};
+        {
+            utils::ProgressReporter::Pause pause;
+            routed_excess = MaximumFlowAlgorithms::augmentShortestPaths(residual_graph, super_source, super_sink, node_capacities);
+        }
+        if (routed_excess != total_excess) {
+            throw std::invalid_argument("There is no flow satisfying the lower bounds of the edges");
+        }
+
+        // the flow sent from source to sink is the flow that came back through the auxiliary node
+        int feasible_flow { residual_graph->hasEdge(source, auxiliary_node) ? residual_graph->getEdgeUnchecked(source, auxiliary_node).getCapacity() : 0 };
+
+        // remove every edge of the super nodes, both directions
+        for (int node : { super_source, super_sink, auxiliary_node }) {
+            residual_graph->getMutableNodeAdjList(node)->clear();
+        }
+        for (int node = 0; node < num_nodes; node++) {
+            for (int super_node : { super_source, super_sink, auxiliary_node }) {
+                if (residual_graph->hasEdge(node, super_node)) {
+                    residual_graph->removeEdgeUnchecked(node, super_node);
+                }
+            }
+        }
+
+        return std::make_shared<dto::FlowResult>(residual_graph, feasible_flow);
+    }
+
+    std::shared_ptr<dto::ParametricFlowResult> MaximumFlowAlgorithms::ParametricMaxFlow(const std::shared_ptr<data_structures::Graph>& graph,
+        int source, int sink, int lambda_min, int lambda_max, bool scale_sink_edges) {
+
+        if (lambda_min < 0 || lambda_min > lambda_max) {
+            throw std::invalid_argument("The range of the parameter must be 0 <= lambda_min <= lambda_max");
+        }
+        for (int u = 0; u < graph->getNumNodes(); u++) {
+            for (auto e : *graph->getNodeAdjList(u)) {
+                if (e.getLowerBound()) {
+                    throw std::invalid_argument("Parametric maximum flow does not support lower bounds");
+                }
+            }
+        }
+        if (!graph->getNodeCapacities()->empty()) {
+            throw std::invalid_argument("Parametric maximum flow does not support node capacities");
+        }
+
+        // a line of the capacity of a cut, with the cut itself
+        using Line = std::tuple<long long, long long, std::shared_ptr<std::vector<int>>>;
 
-        // while there is a path from source to sink
-        while (bfs_result->isPathFound()) {
+        auto get_line = [&](long long numerator, long long denominator) {
+            auto cut = MaximumFlowAlgorithms::getParametricMinCut(graph, source, sink, numerator, denominator, scale_sink_edges);
+            auto [intercept, slope] = MaximumFlowAlgorithms::getCutLine(graph, cut, source, sink, scale_sink_edges);
+            return Line { intercept, slope, cut };
+        };
 
-            auto parent = bfs_result->getParent();
-            
-            // reconstruct the path from source to sink
-            auto path = utils::GraphUtils::RetrievePath(parent, consts::source_parent, sink);
+        // breakpoints as fraction (numerator, denominator) with the line on their right
+        std::vector<std::tuple<long long, long long, Line>> breakpoints;
 
-            // find the minimum residual capacity of the edges in the path
-            auto path_flow = utils::GraphUtils::GetResidualCapacity(residual_graph, path);
+        // intervals to check: λ of the ends as fractions and the lines of their minimum cuts
+        auto first_line = get_line(lambda_min, 1);
+        std::vector<std::tuple<Line, Line>> intervals;
+        intervals.emplace_back(first_line, get_line(lambda_max, 1));
 
-            // update the residual capacities and the current flow
+        while (!intervals.empty()) {
+            auto [left, right] = intervals.back();
+            intervals.pop_back();
+
+            auto [left_intercept, left_slope, left_cut] = left;
+            auto [right_intercept, right_slope, right_cut] = right;
+
+            // same line, no breakpoint inside the interval
+            if (left_slope == right_slope) {
+                continue;
+            }
+
+            // intersection of the two lines: λ = (right_intercept - left_intercept) / (left_slope - right_slope)
+            long long numerator { right_intercept - left_intercept };
+            long long denominator { left_slope - right_slope };
+            if (denominator < 0) {
+                numerator = -numerator;
+                denominator = -denominator;
+            }
+            long long gcd { std::gcd(numerator, denominator) };
+            numerator /= gcd;
+            denominator /= gcd;
+
+            auto middle = get_line(numerator, denominator);
+            auto [middle_intercept, middle_slope, middle_cut] = middle;
+
+            // if the minimum cut at the intersection is not below the lines, the intersection is a breakpoint
+            // (the capacities at λ, multiplied by the denominator, can exceed 64 bits)
+            auto capacity_at = [numerator, denominator](long long intercept, long long slope) {
+                return static_cast<__int128>(intercept) * denominator + static_cast<__int128>(slope) * numerator;
+            };
+            if (capacity_at(middle_intercept, middle_slope) == capacity_at(left_intercept, left_slope)) {
+                breakpoints.emplace_back(numerator, denominator, right);
+            } else {
+                intervals.emplace_back(left, middle);
+                intervals.emplace_back(middle, right);
+            }
+        }
+
+        // sort the breakpoints by λ
+        std::sort(breakpoints.begin(), breakpoints.end(), [](const auto& a, const auto& b) {
+            return static_cast<__int128>(std::get<0>(a)) * std::get<1>(b) < static_cast<__int128>(std::get<0>(b)) * std::get<1>(a);
+        });
+
+        auto breakpoint_values = std::make_shared<std::vector<double>>();
+        auto intercepts = std::make_shared<std::vector<long long>>();
+        auto slopes = std::make_shared<std::vector<long long>>();
+        auto cuts = std::make_shared<std::vector<std::shared_ptr<std::vector<int>>>>();
+
+        intercepts->push_back(std::get<0>(first_line));
+        slopes->push_back(std::get<1>(first_line));
+        cuts->push_back(std::get<2>(first_line));
+
+        for (auto& [numerator, denominator, line] : breakpoints) {
+            breakpoint_values->push_back(static_cast<double>(numerator) / denominator);
+            intercepts->push_back(std::get<0>(line));
+            slopes->push_back(std::get<1>(line));
+            cuts->push_back(std::get<2>(line));
+        }
+
+        return std::make_shared<dto::ParametricFlowResult>(breakpoint_values, intercepts, slopes, cuts);
+    }
+
+    int MaximumFlowAlgorithms::augmentShortestPaths(const std::shared_ptr<data_structures::Graph>& residual_graph, int source, int sink,
+        NodeCapacities& node_capacities) {
+
+        if (!node_capacities.capacity.empty()) {
+            return MaximumFlowAlgorithms::augmentNodeCapacitatedPaths(residual_graph, source, sink, node_capacities);
+        }
+
+        // generic Edmonds-Karp on the adjacent lists of the residual graph
+        data_structures::ResidualGraphView residual_view(residual_graph);
+        return FlowGraphAlgorithms::EdmondsKarp(residual_view, source, sink);
+    }
+
+    int MaximumFlowAlgorithms::augmentNodeCapacitatedPaths(const std::shared_ptr<data_structures::Graph>& residual_graph, int source, int sink,
+        NodeCapacities& node_capacities) {
+
+        // state 2 * node is the entry of the node, 2 * node + 1 its exit (the only state of the nodes without capacity)
+        // the residual graph has the capacity left in each node
+        auto has_capacity = [&residual_graph](int node) {
+            return residual_graph->hasNodeCapacity(node);
+        };
+        auto state = [&has_capacity](int node, bool exit) {
+            return 2 * node + (exit || !has_capacity(node) ? 1 : 0);
+        };
+
+        // the residual edge of an undirected edge from state to next_state cancels the flow sent in the opposite direction
+        // if it leaves the entry of its source or reaches the exit of its sink, otherwise it follows the edge
+        auto cancels_flow = [&has_capacity](int current_state, int next_state) {
+            if (has_capacity(current_state / 2)) {
+                return current_state % 2 == 0;
+            }
+            return has_capacity(next_state / 2) && next_state % 2 == 1;
+        };
+
+        int start { state(source, false) };
+        int target { state(sink, true) };
+        int flow {};
+
+        while (true) {
+            // BFS on the states
+            std::vector<int> parent(2 * residual_graph->getNumNodes(), -1);
+            parent.at(start) = start;
+            std::queue<int> q {};
+            q.push(start);
+
+            while (!q.empty() && parent.at(target) == -1) {
+                int current_state { q.front() };
+                q.pop();
+                int u { current_state / 2 };
+                bool exit { current_state % 2 == 1 };
+
+                auto visit = [&](int next_state) {
+                    if (parent.at(next_state) == -1) {
+                        parent.at(next_state) = current_state;
+                        q.push(next_state);
+                    }
+                };
+
+                // cross the node forward if it has capacity left, backward if it has flow through it
+                if (has_capacity(u)) {
+                    if (!exit && residual_graph->getNodeCapacity(u) > 0) {
+                        visit(state(u, true));
+                    }
+                    if (exit && residual_graph->getNodeCapacity(u) < node_capacities.capacity.at(u)) {
+                        visit(state(u, false));
+                    }
+                }
+
+                for (auto& e : *residual_graph->getNodeAdjList(u)) {
+                    int v { e.getSink() };
+
+                    // the residual edge of an undirected edge follows the edge (exit -> entry) with the capacity
+                    // not used to cancel the flow in the opposite direction, and it cancels that flow (entry -> exit)
+                    auto undirected = node_capacities.undirected_flow.find({ u, v });
+                    if (undirected != node_capacities.undirected_flow.end()) {
+                        int reverse_flow { node_capacities.undirected_flow.at({ v, u }) };
+                        if ((!has_capacity(u) || exit) && e.getCapacity() > reverse_flow) {
+                            visit(state(v, false));
+                        }
+                        if ((!has_capacity(u) || !exit) && reverse_flow > 0) {
+                            visit(state(v, true));
+                        }
+                        continue;
+                    }
+
+                    bool forward { node_capacities.forward_edges.find({ u, v }) != node_capacities.forward_edges.end() };
+                    if (has_capacity(u) && exit != forward) {
+                        continue;
+                    }
+                    visit(state(v, !forward));
+                }
+            }
+
+            if (parent.at(target) == -1) {
+                break;
+            }
+
+            // retrieve the states of the path, the nodes are the path in the residual graph
+            std::vector<int> states;
+            for (int s = target; s != start; s = parent.at(s)) {
+                states.push_back(s);
+            }
+            states.push_back(start);
+            std::reverse(states.begin(), states.end());
+
+            auto path = std::make_shared<std::vector<int>>();
+            int path_flow { std::numeric_limits<int>::max() };
+            for (unsigned i = 0; i < states.size(); i++) {
+                int u { states.at(i) / 2 };
+                if (i && u == states.at(i - 1) / 2) {
+                    // crossing the node
+                    bool forward { states.at(i) % 2 == 1 };
+                    int capacity { residual_graph->getNodeCapacity(u) };
+                    path_flow = std::min(path_flow, forward ? capacity : node_capacities.capacity.at(u) - capacity);
+                    continue;
+                }
+                if (!path->empty()) {
+                    int capacity { residual_graph->getEdgeUnchecked(path->back(), u).getCapacity() };
+                    auto undirected = node_capacities.undirected_flow.find({ path->back(), u });
+                    if (undirected != node_capacities.undirected_flow.end()) {
+                        int reverse_flow { node_capacities.undirected_flow.at({ u, path->back() }) };
+                        capacity = cancels_flow(states.at(i - 1), states.at(i)) ? reverse_flow : capacity - reverse_flow;
+                    }
+                    path_flow = std::min(path_flow, capacity);
+                }
+                path->push_back(u);
+            }
+
+            // update the residual capacities of the edges and of the nodes
             utils::GraphUtils::SendFlowInPathNegativeCosts(residual_graph, path, path_flow);
+            for (unsigned i = 1; i < states.size(); i++) {
+                int u { states.at(i - 1) / 2 };
+                int v { states.at(i) / 2 };
+                if (u == v) {
+                    int capacity { residual_graph->getNodeCapacity(v) };
+                    residual_graph->setNodeCapacity(v, states.at(i) % 2 == 1 ? capacity - path_flow : capacity + path_flow);
+                } else if (node_capacities.undirected_flow.find({ u, v }) != node_capacities.undirected_flow.end()) {
+                    if (cancels_flow(states.at(i - 1), states.at(i))) {
+                        node_capacities.undirected_flow.at({ v, u }) -= path_flow;
+                    } else {
+                        node_capacities.undirected_flow.at({ u, v }) += path_flow;
+                    }
+                }
+            }
 
-            // update the max flow
-            max_flow += path_flow;
+            flow += path_flow;
+            utils::ProgressReporter::Augment(path_flow, 0);
+        }
+
+        return flow;
+    }
 
-            // find a new path from source to sink
-            bfs_result = GraphBaseAlgorithms::BFS(residual_graph, source, sink);
+    std::shared_ptr<std::vector<int>> MaximumFlowAlgorithms::getParametricMinCut(const std::shared_ptr<data_structures::Graph>& graph,
+        int source, int sink, long long numerator, long long denominator, bool scale_sink_edges) {
+        
+        // scale the capacities: parametric edges by the numerator, the fixed ones by the denominator
+        // (an undirected edge is parametric if it has the source, or the sink, at either end);
+        // the scaled capacities are 64-bit, the max flow is bounded by their sum so it fits if the sum does
+        data_structures::WideResidualGraph scaled_graph(graph->getNumNodes());
+        __int128 total_capacity {};
+        for (int u = 0; u < graph->getNumNodes(); u++) {
+            for (const auto& e : graph->getNodeAdjListUnchecked(u)) {
+                bool parametric { scale_sink_edges
+                    ? e.getSink() == sink || (e.isUndirected() && u == sink)
+                    : u == source || (e.isUndirected() && e.getSink() == source) };
+                __int128 capacity { static_cast<__int128>(e.getCapacity()) * (parametric ? numerator : denominator) };
+                total_capacity += e.isUndirected() ? 2 * capacity : capacity;
+                if (total_capacity > std::numeric_limits<long long>::max()) {
+                    throw std::invalid_argument("The scaled capacities of the parametric maximum flow exceed 64 bits");
+                }
+                scaled_graph.addEdge(u, e.getSink(), static_cast<long long>(capacity), e.isUndirected());
+            }
         }
 
-        // Build the result with residual graph and max flow
-        return std::make_shared<dto::FlowResult>(residual_graph, max_flow);
+        utils::ProgressReporter::Pause pause;
+        FlowGraphAlgorithms::EdmondsKarp(scaled_graph, source, sink);
+
+        // the source side of the minimum cut is the set of nodes still reachable from the source
+        std::vector<int> parent;
+        FlowGraphAlgorithms::BFS(scaled_graph, source, sink, parent);
+        auto cut = std::make_shared<std::vector<int>>();
+        for (int node = 0; node < graph->getNumNodes(); node++) {
+            if (node == source || parent.at(node) != -1) {
+                cut->push_back(node);
+            }
+        }
+        return cut;
+    }
+
+    std::pair<long long, long long> MaximumFlowAlgorithms::getCutLine(const std::shared_ptr<data_structures::Graph>& graph, const std::shared_ptr<std::vector<int>>& cut,
+        int source, int sink, bool scale_sink_edges) {
+        
+        std::vector<bool> in_cut(graph->getNumNodes(), false);
+        for (int node : *cut) {
+            in_cut.at(node) = true;
+        }
+
+        long long intercept {};
+        long long slope {};
+
+        // sum the capacities of the edges going from the source side to the sink side
+        // (an undirected edge crosses the cut in both directions)
+        for (int u = 0; u < graph->getNumNodes(); u++) {
+            for (auto e : *graph->getNodeAdjList(u)) {
+                int v { e.getSink() };
+                bool forward { in_cut.at(u) && !in_cut.at(v) };
+                bool backward { e.isUndirected() && in_cut.at(v) && !in_cut.at(u) };
+                if (!forward && !backward) {
+                    continue;
+                }
+                bool parametric { scale_sink_edges ? (forward ? v : u) == sink : (forward ? u : v) == source };
+                if (parametric) {
+                    slope += e.getCapacity();
+                } else {
+                    intercept += e.getCapacity();
+                }
+            }
+        }
+
+        return { intercept, slope };
     }
 }
\ No newline at end of file
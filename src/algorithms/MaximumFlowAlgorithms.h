@@ -3,11 +3,19 @@
 
 #include "data_structures/graph/Graph.h"
 #include "dto/flowResult/FlowResult.h"
+#include "dto/parametricFlowResult/ParametricFlowResult.h"
+
+#include <set>
+#include <map>
+#include <utility>
+#include <functional>
 
 namespace algorithms {
     /**
      * Class containing the following maximum flow algorithms:
      * - Edmonds-Karp
+     * - Feasible flow (lower bounds)
+     * - Parametric maximum flow
      */
     class MaximumFlowAlgorithms {
         public:
@@ -16,6 +24,18 @@ namespace algorithms {
              * Edmonds–Karp algorithm is an implementation of the Ford–Fulkerson method
              * for computing the maximum flow in a flow network.
              * Return the graph and the maximum flow.
+             * If the graph has edges with a lower bound, the algorithm starts from the feasible flow
+             * (see FeasibleFlow()).
+             * The capacities of the nodes are enforced without splitting the nodes: each node with capacity has
+             * an entry and an exit state, the residual edges that follow an original edge go from the exit of their source
+             * to the entry of their sink, the backward ones from the entry to the exit, and the node itself can be crossed
+             * from the entry to the exit while it has capacity left, and back while it has flow through it
+             * (the flow through the source and the sink is limited too). The residual edges of an undirected edge can both
+             * follow the edge and cancel the flow sent in the opposite direction: the flow sent in each direction is kept,
+             * so the flow in both directions goes through the capacity of the nodes.
+             * The graphs with at most SmallGraph::max_nodes nodes, without lower bounds, undirected edges and node capacities,
+             * are solved on a fixed-size matrix with a bitmask BFS (see data_structures::SmallGraph), the dense graphs
+             * on capacity and flow matrices with a BFS on the row bitsets (see data_structures::DenseGraph).
              *
              * (see: https://en.wikipedia.org/wiki/Edmonds%E2%80%93Karp_algorithm)
              * 
@@ -28,8 +48,188 @@ namespace algorithms {
              * @param sink   the sink node
              * 
              * @return the residual graph and the maximum flow
+             * 
+             * @throws invalid_argument if the lower bounds cannot be satisfied
              */
             static std::shared_ptr<dto::FlowResult> EdmondsKarp(const std::shared_ptr<data_structures::Graph>& graph, int source, int sink);
+
+            /**
+             * Feasible flow algorithm.
+             * Find a flow from source to sink which satisfies the lower bound of every edge.
+             * The lower bounds are considered as already sent (see GraphUtils::GetResidualGraph()), so the nodes
+             * are left with an imbalance (see GraphUtils::GetLowerBoundsImbalance()). The imbalances are
+             * fixed with a single maximum flow pass between a super source, connected to the nodes
+             * with excess, and a super sink, connected to the nodes with deficit. The sink is connected
+             * to the source (through an auxiliary node) so that the flow can circulate.
+             * The lower bounds are feasible if and only if all the edges of the super source are saturated.
+             * The super nodes are added directly in the residual graph, the graph is never duplicated.
+             *
+             * (see: https://en.wikipedia.org/wiki/Circulation_problem)
+             *
+             * V: number of nodes
+             * E: number of edges
+             * Time complexity: O(V * E^2)
+             *
+             * @param graph  the graph to solve
+             * @param source the source node
+             * @param sink   the sink node
+             *
+             * @return the residual graph and the flow from source to sink of the feasible flow
+             *
+             * @throws invalid_argument if the lower bounds cannot be satisfied
+             */
+            static std::shared_ptr<dto::FlowResult> FeasibleFlow(const std::shared_ptr<data_structures::Graph>& graph, int source, int sink);
+
+            /**
+             * Parametric maximum flow algorithm.
+             * The capacity of every edge leaving the source (or entering the sink, if scale_sink_edges is true)
+             * is multiplied by the parameter λ, the other capacities are fixed.
+             * The capacity of every cut is a line in λ (fixed capacities + λ * parametric capacities),
+             * so the maximum flow, the minimum of these lines, is a concave piecewise linear function of λ.
+             * Its breakpoints are found intersecting the lines of the minimum cuts at the ends of an interval:
+             * if the minimum cut at the intersection has the same capacity of the lines the intersection is a breakpoint,
+             * otherwise the interval is split at the intersection (Eisner-Severance method).
+             * Only one maximum flow per breakpoint (plus one per segment) is computed, instead of one for each value of λ.
+             * As in the Gallo-Grigoriadis-Tarjan setting the parametric capacities are monotone, so the minimum cuts
+             * are nested: the source side grows with λ (shrinks if scale_sink_edges is true).
+             * The maximum flow at the rational value λ = p / q is computed scaling the parametric capacities by p
+             * and the fixed ones by q, so all the capacities stay integers: the scaled capacities, the flows and the
+             * lines of the cuts are 64-bit (see data_structures::WideResidualGraph), the comparisons of the capacities
+             * at a breakpoint 128-bit.
+             * This is not the single-run algorithm of Gallo, Grigoriadis and Tarjan (one push-relabel run
+             * for all the breakpoints): every probe runs a full Edmonds-Karp from scratch on the scaled graph,
+             * so the cost is one maximum flow per probe (at most 2K + 1 probes).
+             *
+             * (see: https://doi.org/10.1137/0218003)
+             *
+             * V: number of nodes
+             * E: number of edges
+             * K: number of breakpoints
+             * Time complexity: O(K * V * E^2 * log(V))
+             *
+             * @param graph            the graph to solve (without lower bounds)
+             * @param source           the source node
+             * @param sink             the sink node
+             * @param lambda_min       the minimum value of the parameter (>= 0)
+             * @param lambda_max       the maximum value of the parameter
+             * @param scale_sink_edges true to multiply the edges entering the sink, false for the edges leaving the source
+             *
+             * @return the breakpoints, the maximum flow of each segment and the nested minimum cuts
+             *
+             * @throws invalid_argument if the range of the parameter is not valid
+             * @throws invalid_argument if the graph has lower bounds or node capacities
+             * @throws invalid_argument if the sum of the scaled capacities at a probe exceeds 64 bits
+             */
+            static std::shared_ptr<dto::ParametricFlowResult> ParametricMaxFlow(const std::shared_ptr<data_structures::Graph>& graph,
+                int source, int sink, int lambda_min, int lambda_max, bool scale_sink_edges);
+
+        private:
+            /**
+             * Capacities of the nodes, enforced on the residual graph without splitting the nodes (see EdmondsKarp()).
+             * The residual graph has the capacity left in each node.
+             */
+            struct NodeCapacities {
+                // capacity of each node with limited flow
+                std::map<int, int> capacity;
+
+                // residual edges (with a node with capacity) that follow an original edge
+                std::set<std::pair<int, int>> forward_edges;
+
+                // flow sent on the residual edges of the undirected edges (with a node with capacity)
+                // from the exit of their source to the entry of their sink
+                std::map<std::pair<int, int>, int> undirected_flow;
+            };
+
+            /**
+             * Feasible flow algorithm (see FeasibleFlow()), it also returns the capacities of the nodes
+             * used by the following augmentations.
+             *
+             * @param graph           the graph to solve
+             * @param source          the source node
+             * @param sink            the sink node
+             * @param node_capacities the capacities of the nodes of the residual graph (output)
+             *
+             * @return the residual graph and the flow from source to sink of the feasible flow
+             */
+            static std::shared_ptr<dto::FlowResult> feasibleFlow(const std::shared_ptr<data_structures::Graph>& graph, int source, int sink,
+                NodeCapacities& node_capacities);
+
+            /**
+             * Build the result of a maximum flow found on a matrix representation (see data_structures::SmallGraph
+             * and data_structures::DenseGraph). The net flow of each pair of nodes is assigned to their edges by id,
+             * and the residual graph is built directly from the flow of each edge in the same pass (no augmenting path
+             * is sent again), so the result is the same of the general algorithm.
+             *
+             * @param graph     the solved graph
+             * @param max_flow  the maximum flow
+             * @param pair_flow the net flow from the first to the second node of a pair
+             *
+             * @return the residual graph, the maximum flow and the flow of each edge
+             */
+            static std::shared_ptr<dto::FlowResult> getMatrixFlowResult(const std::shared_ptr<data_structures::Graph>& graph, int max_flow,
+                const std::function<int(int, int)>& pair_flow);
+
+            /**
+             * Send flow from source to sink along shortest augmenting paths until
+             * no more paths are found (main loop of Edmonds-Karp).
+             * The residual graph is updated in place.
+             *
+             * @param residual_graph  the residual graph
+             * @param source          the source node
+             * @param sink            the sink node
+             * @param node_capacities the capacities of the nodes (the flow of the undirected edges is updated)
+             *
+             * @return the flow sent
+             */
+            static int augmentShortestPaths(const std::shared_ptr<data_structures::Graph>& residual_graph, int source, int sink,
+                NodeCapacities& node_capacities);
+
+            /**
+             * Send flow from source to sink along shortest augmenting paths respecting the capacities of the nodes.
+             * The BFS visits the entry and the exit state of each node with capacity (see EdmondsKarp()),
+             * so the paths are at most twice as long, and the capacity left in the nodes is updated in place.
+             *
+             * @param residual_graph  the residual graph
+             * @param source          the source node
+             * @param sink            the sink node
+             * @param node_capacities the capacities of the nodes (the flow of the undirected edges is updated)
+             *
+             * @return the flow sent
+             */
+            static int augmentNodeCapacitatedPaths(const std::shared_ptr<data_structures::Graph>& residual_graph, int source, int sink,
+                NodeCapacities& node_capacities);
+
+            /**
+             * Get the source side of the minimum cut of the parametric graph for λ = numerator / denominator.
+             *
+             * @param graph            the graph
+             * @param source           the source node
+             * @param sink             the sink node
+             * @param numerator        the numerator of λ
+             * @param denominator      the denominator of λ
+             * @param scale_sink_edges true if the parametric edges are the ones entering the sink
+             *
+             * @return the source side of the minimum cut
+             *
+             * @throws invalid_argument if the sum of the scaled capacities exceeds 64 bits
+             */
+            static std::shared_ptr<std::vector<int>> getParametricMinCut(const std::shared_ptr<data_structures::Graph>& graph,
+                int source, int sink, long long numerator, long long denominator, bool scale_sink_edges);
+
+            /**
+             * Get the line of the capacity of a cut: the capacity of its fixed edges (intercept) and
+             * the capacity of its parametric edges (slope).
+             *
+             * @param graph            the graph
+             * @param cut              the source side of the cut
+             * @param source           the source node
+             * @param sink             the sink node
+             * @param scale_sink_edges true if the parametric edges are the ones entering the sink
+             *
+             * @return the intercept and the slope of the line
+             */
+            static std::pair<long long, long long> getCutLine(const std::shared_ptr<data_structures::Graph>& graph, const std::shared_ptr<std::vector<int>>& cut,
+                int source, int sink, bool scale_sink_edges);
     };
 }
 
@@ -1,36 +1,99 @@
 #include "MinimumCostFlowAlgorithms.h"
 
 #include "utils/GraphUtils.h"
+#include "utils/ProgressReporter.h"
+#include "consts/Consts.h"
 #include "GraphBaseAlgorithms.h"
 #include "MaximumFlowAlgorithms.h"
+#include "data_structures/dynamicShortestPaths/DynamicShortestPaths.h"
+#include "data_structures/denseGraph/DenseGraph.h"
 
 #include <map>
 #include <queue>
+#include <atomic>
+#include <limits>
 #include <memory>
+#include <numeric>
+#include <functional>
+#include <thread>
+#include <memory_resource>
+#include <algorithm>
+#include <exception>
 #include <stdexcept>
 
 namespace algorithms {
     std::shared_ptr<dto::FlowResult> MinimumCostFlowAlgorithms::CycleCancelling(const std::shared_ptr<data_structures::Graph>& graph,
         int source, int sink) {
 
+        MinimumCostFlowAlgorithms::checkLinearCosts(graph);
+        if (utils::GraphUtils::HasUndirectedEdges(graph) || !graph->getNodeCapacities()->empty()) {
+            return MinimumCostFlowAlgorithms::solveExpanded(graph, source, sink, MinimumCostFlowAlgorithms::CycleCancelling);
+        }
+
         // get the maximum flow using Edmonds-Karp (feasible flow)
-        auto edmonds_karps_result = MaximumFlowAlgorithms::EdmondsKarp(graph, source, sink);
+        std::shared_ptr<dto::FlowResult> edmonds_karps_result;
+        {
+            utils::ProgressReporter::Pause pause;
+            edmonds_karps_result = MaximumFlowAlgorithms::EdmondsKarp(graph, source, sink);
+        }
         
         // get the residual graph
         auto residual_graph = edmonds_karps_result->getGraph();
+
+        // the maximum flow is the first augmentation, with the cost of its flow above the lower bounds
+        if (utils::ProgressReporter::IsReporting()) {
+            int flow_cost { MinimumCostFlowAlgorithms::getMinimumCost(utils::GraphUtils::GetOptimalGraph(residual_graph, graph)) };
+            for (int u = 0; u < graph->getNumNodes(); u++) {
+                for (const auto& e : graph->getNodeAdjListUnchecked(u)) {
+                    flow_cost -= graph->getFlowCost(e, e.getLowerBound());
+                }
+            }
+            utils::ProgressReporter::Augment(edmonds_karps_result->getFlow(), flow_cost);
+        }
         
-        // get the negative cycle using Bellman-Ford
-        auto bellman_ford_result = GraphBaseAlgorithms::BellmanFord(residual_graph, source);
+        // the negative cycles can only be inside the non-trivial strongly connected components of the residual graph
+        std::vector<std::vector<int>> components;
+        auto strongly_connected_components = GraphBaseAlgorithms::StronglyConnectedComponents(residual_graph);
+        for (auto& component : *strongly_connected_components) {
+            if (component.size() > 1) {
+                components.push_back(component);
+            }
+        }
+
+        // while there is a negative cycle in a component augment the flow
+        while (!components.empty()) {
+            auto component = components.back();
+            components.pop_back();
+
+            // get the negative cycle using Bellman-Ford on the component
+            auto bellman_ford_result = GraphBaseAlgorithms::FindNegativeCycle(residual_graph, component);
+            if (!bellman_ford_result->hasNegativeCycle()) {
+                continue;
+            }
 
-        // while there is a negative cycle in the residual graph augment the flow
-        while (bellman_ford_result->hasNegativeCycle()) {
             auto negative_cycle = bellman_ford_result->getNegativeCycle();
             int residual_capacity { utils::GraphUtils::GetResidualCapacity(residual_graph, negative_cycle) };
 
+            // the cancelled cycle does not change the flow, only its cost
+            if (utils::ProgressReporter::IsReporting()) {
+                int cycle_cost {};
+                for (unsigned i = 0; i + 1 < negative_cycle->size(); i++) {
+                    cycle_cost += residual_graph->getEdgeUnchecked((*negative_cycle)[i], (*negative_cycle)[i + 1]).getCost();
+                }
+                utils::ProgressReporter::Augment(0, cycle_cost * residual_capacity);
+            }
+
             // update the residual capacities and the current flow (augment flow)
             utils::GraphUtils::SendFlowInPathNegativeCosts(residual_graph, negative_cycle, residual_capacity);
 
-            bellman_ford_result = GraphBaseAlgorithms::BellmanFord(residual_graph, source);
+            // the saturated edges are removed and the backward edges are added inside the component,
+            // so the component can only split: update only its strongly connected components
+            auto sub_components = GraphBaseAlgorithms::StronglyConnectedComponents(residual_graph, component);
+            for (auto& sub_component : *sub_components) {
+                if (sub_component.size() > 1) {
+                    components.push_back(sub_component);
+                }
+            }
         }
 
        // get the optimal graph
@@ -38,55 +101,96 @@ namespace algorithms {
 
         // get minimum cost
         int minimum_cost { MinimumCostFlowAlgorithms::getMinimumCost(optimal_graph) };
+        auto edge_flow = utils::GraphUtils::GetEdgeFlow(optimal_graph, graph);
 
-        return std::make_shared<dto::FlowResult>(optimal_graph, minimum_cost);
+        return std::make_shared<dto::FlowResult>(optimal_graph, minimum_cost, edge_flow);
     }
 
     std::shared_ptr<dto::FlowResult> MinimumCostFlowAlgorithms::SuccessiveShortestPath(const std::shared_ptr<data_structures::Graph>& graph,
         int source, int sink) {
 
+        MinimumCostFlowAlgorithms::checkLinearCosts(graph);
+        if (utils::GraphUtils::HasUndirectedEdges(graph) || !graph->getNodeCapacities()->empty()) {
+            return MinimumCostFlowAlgorithms::solveExpanded(graph, source, sink, MinimumCostFlowAlgorithms::SuccessiveShortestPath);
+        }
+
+        // dense graphs are solved on the dense matrices
+        if (data_structures::DenseGraph::IsSupported(graph)) {
+            return MinimumCostFlowAlgorithms::denseSuccessiveShortestPath(graph, source, sink);
+        }
+
         // get the residual graph
         auto residual_graph = utils::GraphUtils::GetResidualGraph(graph);
 
-        // check if there is a negative cycle, if so Successive Shortest Path cannot be applied
-        auto bellman_ford_result = GraphBaseAlgorithms::BellmanFord(residual_graph, source);
-        if (bellman_ford_result->hasNegativeCycle()) {
-            throw std::invalid_argument("The graph has a negative cycle, Successive Shortest Path cannot be applied");
-        }
+        // the Bellman-Ford distances give the initial potentials, so the reduced costs are non-negative
+        // also with negative costs (if there is a negative cycle Successive Shortest Path cannot be applied)
+        auto initial_potential = MinimumCostFlowAlgorithms::getInitialPotentials(residual_graph);
 
-        // get the maximum flow using Edmonds-Karp (feasible flow)
-        auto edmonds_karps_result = MaximumFlowAlgorithms::EdmondsKarp(residual_graph, source, sink);
+        // get the maximum flow using Edmonds-Karp (feasible flow), only its value is used
+        std::shared_ptr<dto::FlowResult> edmonds_karps_result;
+        {
+            utils::ProgressReporter::Pause pause;
+            edmonds_karps_result = MaximumFlowAlgorithms::EdmondsKarp(graph, source, sink);
+        }
 
         int num_nodes { residual_graph->getNumNodes() };
         std::vector<int> imbalance(num_nodes, 0); // imbalance of each node
-        imbalance.at(source) = edmonds_karps_result->getFlow(); // imbalance of the source node is the max flow
-        imbalance.at(sink) = -edmonds_karps_result->getFlow(); // imbalance of the sink node is the negative max flow
 
-        std::vector<int> potential(num_nodes, 0); // potential of each node 
+        // the lower bounds are already sent in the residual graph, start from their imbalances
+        auto lower_bounds_imbalance = utils::GraphUtils::GetLowerBoundsImbalance(graph);
+        std::copy(lower_bounds_imbalance->begin(), lower_bounds_imbalance->end(), imbalance.begin());
+
+        imbalance.at(source) += edmonds_karps_result->getFlow(); // the source node sends the max flow
+        imbalance.at(sink) -= edmonds_karps_result->getFlow(); // the sink node receives the max flow
+
+        std::vector<int> potential(std::move(initial_potential)); // potential of each node
 
         // container for the nodes with imbalance > 0
         std::vector<int> positive_imbalance;
-        positive_imbalance.push_back(source);
 
         // container for the nodes with imbalance < 0
         std::vector<int> negative_imbalance;
-        negative_imbalance.push_back(sink);
+
+        int total_imbalance {};
+        for (int u = 0; u < num_nodes; u++) {
+            if (imbalance.at(u) > 0) {
+                positive_imbalance.push_back(u);
+                total_imbalance += imbalance.at(u);
+            } else if (imbalance.at(u) < 0) {
+                negative_imbalance.push_back(u);
+            }
+        }
 
         int flow {};
 
+        // shortest path tree repaired after each augmentation, computed from scratch only when the start node changes.
+        // The residual graph keeps the original costs, the reduced costs are evaluated with the potentials
+        std::unique_ptr<data_structures::DynamicShortestPaths> shortest_paths;
+
         // if there are nodes with imbalance > 0 there also must be nodes with imbalance < 0
         while (!positive_imbalance.empty()) {
             int k { positive_imbalance.back() };
             positive_imbalance.pop_back();
-            int l { negative_imbalance.back() };
-            negative_imbalance.pop_back();
 
-            auto dijkstra_result = GraphBaseAlgorithms::Dijkstra(residual_graph, k);
-            auto distance = dijkstra_result->getDistance();
-            auto parent = dijkstra_result->getParent();
+            if (!shortest_paths) {
+                shortest_paths = std::make_unique<data_structures::DynamicShortestPaths>(residual_graph, k, potential);
+            } else if (shortest_paths->getSource() != k) {
+                shortest_paths->reset(k);
+            }
+
+            // the node with imbalance < 0 nearest to k (with more than one node with imbalance < 0
+            // not all of them could be reachable from k)
+            auto nearest = std::min_element(negative_imbalance.begin(), negative_imbalance.end(), [&shortest_paths](int a, int b) {
+                return shortest_paths->getDistance(a) < shortest_paths->getDistance(b);
+            });
+            if (nearest == negative_imbalance.end() || shortest_paths->getDistance(*nearest) == std::numeric_limits<int>::max()) {
+                throw std::runtime_error("Max flow not reached");
+            }
+            int l { *nearest };
+            negative_imbalance.erase(nearest);
 
             // get path between k and l
-            auto path = utils::GraphUtils::RetrievePath(parent, k, l);
+            auto path = shortest_paths->getPath(l);
 
             // get the minimum residual capacity in the path
             int residual_capacity { utils::GraphUtils::GetResidualCapacity(residual_graph, path) };
@@ -109,96 +213,141 @@ namespace algorithms {
                 negative_imbalance.push_back(l);
             }
 
-            // update node potentials
-            for (int u = 0; u < num_nodes; u++) {
-                potential.at(u) = potential.at(u) - distance->at(u);
-            }
-            
-            // send the flow in the path and update the residual graph
-            utils::GraphUtils::SendFlowInPathReducedCosts(residual_graph, path, augment_flow); 
-            
-            // update reduced costs
-            for (int u = 0; u < num_nodes; u++) {
-                for (auto edge: *residual_graph->getNodeAdjList(u)) {
-                    if (edge.getCost() <= 0) {
-                        continue;
-                    }
-                    int new_weight { edge.getCost() - potential.at(u) + potential.at(edge.getSink()) };
-                    residual_graph->setEdgeCost(u, edge.getSink(), new_weight);
-                }
-            }
+            // update node potentials (the edges of the path get zero reduced cost)
+            shortest_paths->shiftDistances(l);
+
+            // with zero reduced costs the cost of the path is the difference of the potentials of its ends
+            utils::ProgressReporter::Augment(augment_flow, augment_flow * (potential.at(k) - potential.at(l)));
+
+            // send the flow in the path and update the residual graph (the backward edges get the opposite cost)
+            utils::GraphUtils::SendFlowInPathNegativeCosts(residual_graph, path, augment_flow);
+            shortest_paths->repair(path);
 
             flow += augment_flow;
         }
 
-        if (flow != edmonds_karps_result->getFlow()) {
+        if (flow != total_imbalance) {
             throw std::runtime_error("Max flow not reached");
         }
 
         auto optimal_graph = utils::GraphUtils::GetOptimalGraph(residual_graph, graph);
         int minimum_cost { MinimumCostFlowAlgorithms::getMinimumCost(optimal_graph) };
+        auto edge_flow = utils::GraphUtils::GetEdgeFlow(optimal_graph, graph);
+
+        // the potentials certify the optimality of the flow (dual values)
+        auto node_potential = MinimumCostFlowAlgorithms::getNodePotentials(graph, potential, source);
+        auto reduced_cost_graph = MinimumCostFlowAlgorithms::getReducedCostGraph(optimal_graph, node_potential);
+
+        return std::make_shared<dto::FlowResult>(optimal_graph, minimum_cost, edge_flow, node_potential, reduced_cost_graph);
+    }
+
+    std::shared_ptr<dto::FlowResult> MinimumCostFlowAlgorithms::denseSuccessiveShortestPath(const std::shared_ptr<data_structures::Graph>& graph,
+        int source, int sink) {
+        data_structures::DenseGraph dense_graph(graph);
+        std::vector<int> potential;
+        int max_flow { dense_graph.minCostMaxFlow(source, sink, potential) };
+
+        // the optimal graph has the flow of each edge as capacity (same ids, see GraphUtils::GetOptimalGraph())
+        auto optimal_graph = std::make_shared<data_structures::Graph>(graph->getNumNodes(), graph->isMultigraph(), graph->getMemoryResource());
+        for (int u = 0; u < graph->getNumNodes(); u++) {
+            for (auto e : *graph->getNodeAdjList(u)) {
+                e.setCapacity(dense_graph.getFlow(u, e.getSink()));
+                optimal_graph->addEdge(e);
+            }
+        }
+
+        int minimum_cost { MinimumCostFlowAlgorithms::getMinimumCost(optimal_graph) };
+        auto edge_flow = utils::GraphUtils::GetEdgeFlow(optimal_graph, graph);
+        utils::ProgressReporter::Augment(max_flow, minimum_cost);
 
-        return std::make_shared<dto::FlowResult>(optimal_graph, minimum_cost);
+        // the potentials certify the optimality of the flow (dual values)
+        auto node_potential = MinimumCostFlowAlgorithms::getNodePotentials(graph, potential, source);
+        auto reduced_cost_graph = MinimumCostFlowAlgorithms::getReducedCostGraph(optimal_graph, node_potential);
+
+        return std::make_shared<dto::FlowResult>(optimal_graph, minimum_cost, edge_flow, node_potential, reduced_cost_graph);
     }
 
     std::shared_ptr<dto::FlowResult> MinimumCostFlowAlgorithms::PrimalDual(const std::shared_ptr<data_structures::Graph>& graph, int source, int sink) {
-        
+
+        MinimumCostFlowAlgorithms::checkLinearCosts(graph);
+        if (utils::GraphUtils::HasUndirectedEdges(graph) || !graph->getNodeCapacities()->empty()) {
+            return MinimumCostFlowAlgorithms::solveExpanded(graph, source, sink, MinimumCostFlowAlgorithms::PrimalDual);
+        }
+
         // get the residual graph
         auto residual_graph = utils::GraphUtils::GetResidualGraph(graph);
 
-        // check if there is a negative cycle, if so Successive Shortest Path cannot be applied
-        auto bellman_ford_result = GraphBaseAlgorithms::BellmanFord(residual_graph, source);
-        if (bellman_ford_result->hasNegativeCycle()) {
-            throw std::invalid_argument("The graph has a negative cycle, Successive Shortest Path cannot be applied");
-        }
+        // the Bellman-Ford distances give the initial potentials, so the reduced costs are non-negative
+        // also with negative costs (if there is a negative cycle Successive Shortest Path cannot be applied)
+        auto initial_potential = MinimumCostFlowAlgorithms::getInitialPotentials(residual_graph);
 
-        // get the maximum flow using Edmonds-Karp
-        auto edmonds_karps_result = MaximumFlowAlgorithms::EdmondsKarp(residual_graph, source, sink);
+        // get the maximum flow using Edmonds-Karp, only its value is used
+        std::shared_ptr<dto::FlowResult> edmonds_karps_result;
+        {
+            utils::ProgressReporter::Pause pause;
+            edmonds_karps_result = MaximumFlowAlgorithms::EdmondsKarp(graph, source, sink);
+        }
 
         int num_nodes { residual_graph->getNumNodes() + 2 };
 
-        int current_imbalance { edmonds_karps_result->getFlow() };  // current imbalance
-        std::vector<int> potential(num_nodes, 0);                   // potential of each node 
+        // the lower bounds are already sent in the residual graph, start from their imbalances
+        auto imbalance = utils::GraphUtils::GetLowerBoundsImbalance(graph);
+        imbalance->at(source) += edmonds_karps_result->getFlow(); // the source node sends the max flow
+        imbalance->at(sink) -= edmonds_karps_result->getFlow(); // the sink node receives the max flow
+
+        int current_imbalance {};                                   // current imbalance
+        std::vector<int> potential(num_nodes, 0);                   // potential of each node
         int flow {};                                                // current flow
 
-        // add source edge
-        auto new_source { num_nodes - 2 };
-        residual_graph->addEdge(new_source, source, current_imbalance, 0);
+        // the residual graph keeps the reduced costs, start from the ones of the initial potentials
+        for (int u = 0; u < num_nodes - 2; u++) {
+            potential.at(u) = initial_potential.at(u);
+            for (auto& edge: *residual_graph->getMutableNodeAdjList(u)) {
+                edge.setCost(edge.getCost() - initial_potential.at(u) + initial_potential.at(edge.getSink()));
+            }
+        }
 
-        // add sink edge
+        // add source edges (to the nodes with imbalance > 0) and sink edges (from the nodes with imbalance < 0).
+        // The potentials are non-negative, with potential 0 for the new source and the maximum one for the new sink
+        // the reduced costs of the new edges (of cost 0) are non-negative too
+        auto new_source { num_nodes - 2 };
         auto new_sink { num_nodes - 1 };
-        residual_graph->addEdge(sink, new_sink, current_imbalance, 0);
-
-        // get the original graph
-        auto original_graph = std::make_shared<data_structures::Graph>(residual_graph);
+        potential.at(new_sink) = *std::max_element(potential.begin(), potential.end());
+        for (int u = 0; u < static_cast<int>(imbalance->size()); u++) {
+            if (imbalance->at(u) > 0) {
+                residual_graph->addEdge(new_source, u, imbalance->at(u), potential.at(u) - potential.at(new_source));
+                current_imbalance += imbalance->at(u);
+            } else if (imbalance->at(u) < 0) {
+                residual_graph->addEdge(u, new_sink, -imbalance->at(u), potential.at(new_sink) - potential.at(u));
+            }
+        }
+        int total_imbalance { current_imbalance };
 
         while (current_imbalance > 0) {
             // get the shortest path from source to sink
-            auto dijkstra_result = GraphBaseAlgorithms::Dijkstra(residual_graph, new_source);
+            auto dijkstra_result = GraphBaseAlgorithms::Dijkstra(*residual_graph, new_source);
             auto distance = dijkstra_result->getDistance();
             auto parent = dijkstra_result->getParent();
 
-            for (int u = 0; u < num_nodes; u++) {
-                potential.at(u) = potential.at(u) - distance->at(u);
-            }
-            
-            // update reduced costs
-            for (int u = 0; u < num_nodes; u++) {
-                for (auto edge: *residual_graph->getNodeAdjList(u)) {
-                    if (edge.getCost() <= 0) {
-                        continue;
-                    }
-                    int new_weight { edge.getCost() - potential.at(u) + potential.at(edge.getSink()) };
-                    residual_graph->setEdgeCost(u, edge.getSink(), new_weight);
-                }
-            }
+            // update node potentials and reduced costs
+            MinimumCostFlowAlgorithms::updateReducedCosts(residual_graph, distance, new_sink, potential);
+
             // get admissible network 
             auto admissible_graph = utils::GraphUtils::GetAdmissibleGraph(residual_graph);
             
-            auto flow_result = MaximumFlowAlgorithms::EdmondsKarp(admissible_graph, new_source, new_sink);
+            // the paths of the admissible network have zero reduced cost, the phase is reported as a single augmentation
+            std::shared_ptr<dto::FlowResult> flow_result;
+            {
+                utils::ProgressReporter::Pause pause;
+                flow_result = MaximumFlowAlgorithms::EdmondsKarp(admissible_graph, new_source, new_sink);
+            }
             int admissible_flow { flow_result->getFlow() };
+            if (!admissible_flow) {
+                throw std::runtime_error("Max flow not reached");
+            }
+            utils::ProgressReporter::Augment(admissible_flow, admissible_flow * (potential.at(new_source) - potential.at(new_sink)));
 
-            auto flow_graph =  utils::GraphUtils::GetOptimalGraph(flow_result->getGraph(), residual_graph);
+            auto flow_graph =  utils::GraphUtils::GetOptimalGraph(flow_result->getGraph(), admissible_graph);
             flow += admissible_flow;
 
             // update current imbalance
@@ -213,8 +362,9 @@ namespace algorithms {
                     int sink { edge.getSink() };
                     int edge_flow { edge.getCapacity() };
 
-                    // subtract flow from the residual capacity of the edge
-                    int capacity { residual_graph->getEdge(source, sink).getCapacity() };
+                    // subtract flow from the residual capacity of the edge (read and updated with a single lookup)
+                    auto& residual_edge = residual_graph->getMutableEdgeUnchecked(source, sink);
+                    int capacity { residual_edge.getCapacity() };
 
                     if (capacity < edge_flow) {
                         throw std::invalid_argument("The flow is greater than the residual capacity of the edge");
@@ -223,9 +373,9 @@ namespace algorithms {
                     capacity -= edge_flow;
                     // if residual capacity is 0, remove the edge
                     if (!capacity) {
-                        residual_graph->removeEdge(source, sink);
+                        residual_graph->removeEdgeUnchecked(source, sink);
                     } else {
-                        residual_graph->setEdgeCapacity(source, sink, capacity);
+                        residual_edge.setCapacity(capacity);
                     }
 
                     // if the reverse edge does not exist, add it
@@ -233,35 +383,750 @@ namespace algorithms {
                         if (!residual_graph->hasEdge(sink, source)) {
                             residual_graph->addEdge(sink, source, edge_flow, 0);
                         } else {
-                            residual_graph->setEdgeCapacity(sink, source, residual_graph->getEdge(sink, source).getCapacity() + edge_flow);
+                            auto& reverse_edge = residual_graph->getMutableEdgeUnchecked(sink, source);
+                            reverse_edge.setCapacity(reverse_edge.getCapacity() + edge_flow);
                         }
                     }
                 }
             }
         }
 
-        if (flow != edmonds_karps_result->getFlow()) {
+        if (flow != total_imbalance) {
             throw std::runtime_error("Max flow not reached");
         }
 
         // remove the source and sink edges (both directions)
-        if (residual_graph->hasEdge(new_source, source)) {
-            residual_graph->removeEdge(new_source, source);
+        for (int u = 0; u < static_cast<int>(imbalance->size()); u++) {
+            if (residual_graph->hasEdge(new_source, u)) {
+                residual_graph->removeEdgeUnchecked(new_source, u);
+            }
+            if (residual_graph->hasEdge(u, new_source)) {
+                residual_graph->removeEdgeUnchecked(u, new_source);
+            }
+            if (residual_graph->hasEdge(u, new_sink)) {
+                residual_graph->removeEdgeUnchecked(u, new_sink);
+            }
+            if (residual_graph->hasEdge(new_sink, u)) {
+                residual_graph->removeEdgeUnchecked(new_sink, u);
+            }
         }
-        if (residual_graph->hasEdge(source, new_source)) {
-            residual_graph->removeEdge(source, new_source);
+
+        auto optimal_graph = utils::GraphUtils::GetOptimalGraph(residual_graph, graph);
+        int minimum_cost { MinimumCostFlowAlgorithms::getMinimumCost(optimal_graph) };
+        auto edge_flow = utils::GraphUtils::GetEdgeFlow(optimal_graph, graph);
+
+        // the potentials certify the optimality of the flow (dual values)
+        auto node_potential = MinimumCostFlowAlgorithms::getNodePotentials(graph, potential, source);
+        auto reduced_cost_graph = MinimumCostFlowAlgorithms::getReducedCostGraph(optimal_graph, node_potential);
+
+        return std::make_shared<dto::FlowResult>(optimal_graph, minimum_cost, edge_flow, node_potential, reduced_cost_graph);
+    }
+
+    std::shared_ptr<dto::FlowResult> MinimumCostFlowAlgorithms::ConvexCostFlow(const std::shared_ptr<data_structures::Graph>& graph,
+        int source, int sink) {
+
+        if (utils::GraphUtils::HasUndirectedEdges(graph) || !graph->getNodeCapacities()->empty()) {
+            return MinimumCostFlowAlgorithms::solveExpanded(graph, source, sink, MinimumCostFlowAlgorithms::ConvexCostFlow);
         }
-        if (residual_graph->hasEdge(sink, new_sink)) {
-            residual_graph->removeEdge(sink, new_sink);
+
+        const int INF { std::numeric_limits<int>::max() };
+        int num_nodes { graph->getNumNodes() };
+
+        // get the maximum flow using Edmonds-Karp (the costs are not used), only its value is used
+        std::shared_ptr<dto::FlowResult> edmonds_karps_result;
+        {
+            utils::ProgressReporter::Pause pause;
+            edmonds_karps_result = MaximumFlowAlgorithms::EdmondsKarp(graph, source, sink);
         }
-        if (residual_graph->hasEdge(new_sink, sink)) {
-            residual_graph->removeEdge(new_sink, sink);
+
+        // the lower bounds are considered as already sent, start from their imbalances
+        auto imbalance = utils::GraphUtils::GetLowerBoundsImbalance(graph);
+        imbalance->at(source) += edmonds_karps_result->getFlow(); // the source node sends the max flow
+        imbalance->at(sink) -= edmonds_karps_result->getFlow(); // the sink node receives the max flow
+
+        // edges with their breakpoints (end of each segment) and the cost of each segment,
+        // a linear edge has only one segment
+        std::vector<data_structures::Edge> edges;
+        std::vector<std::vector<int>> breakpoints;
+        std::vector<std::vector<int>> segment_costs;
+        std::vector<int> flow;
+
+        // residual arcs leaving each node: (edge index, forward)
+        std::vector<std::vector<std::pair<int, bool>>> adj_list(num_nodes);
+
+        for (int u = 0; u < num_nodes; u++) {
+            for (auto edge: *graph->getNodeAdjList(u)) {
+                int index { static_cast<int>(edges.size()) };
+                std::vector<int> ends;
+                std::vector<int> costs;
+                if (auto cost_segments = graph->getCostSegments(edge.getId())) {
+                    int end {};
+                    for (auto [width, cost] : *cost_segments) {
+                        end += width;
+                        ends.push_back(end);
+                        costs.push_back(cost);
+                    }
+                } else {
+                    ends.push_back(edge.getCapacity());
+                    costs.push_back(edge.getCost());
+                }
+
+                edges.push_back(edge);
+                breakpoints.push_back(ends);
+                segment_costs.push_back(costs);
+                flow.push_back(edge.getLowerBound());
+
+                adj_list.at(u).emplace_back(index, true);
+                adj_list.at(edge.getSink()).emplace_back(index, false);
+            }
+        }
+
+        // segment of the unit of flow number x (starting from 0) of the edge
+        auto segment = [&breakpoints](int edge, int x) {
+            auto& ends = breakpoints.at(edge);
+            return static_cast<int>(std::upper_bound(ends.begin(), ends.end(), x) - ends.begin());
+        };
+
+        // residual arc of the edge: (cost, residual capacity up to the next breakpoint), capacity 0 if the arc does not exist
+        auto residual_arc = [&](int edge, bool forward) {
+            int x { flow.at(edge) };
+            if (forward) {
+                if (x >= edges.at(edge).getCapacity()) {
+                    return std::make_pair(0, 0);
+                }
+                int k { segment(edge, x) };
+                return std::make_pair(segment_costs.at(edge).at(k), std::min(breakpoints.at(edge).at(k), edges.at(edge).getCapacity()) - x);
+            }
+            if (x <= edges.at(edge).getLowerBound()) {
+                return std::make_pair(0, 0);
+            }
+            int k { segment(edge, x - 1) };
+            int start { k ? breakpoints.at(edge).at(k - 1) : 0 };
+            return std::make_pair(-segment_costs.at(edge).at(k), x - std::max(start, edges.at(edge).getLowerBound()));
+        };
+
+        auto arc_sink = [&edges](int edge, bool forward) {
+            return forward ? edges.at(edge).getSink() : edges.at(edge).getSource();
+        };
+
+        // initial potentials with Bellman-Ford from a virtual node connected to every node with cost 0
+        // (the costs can be negative), the reduced cost of the arc u -> v is cost - potential[u] + potential[v]
+        std::vector<int> potential(num_nodes, 0);
+        bool updated { true };
+        for (int i = 0; i <= num_nodes && updated; i++) {
+            updated = false;
+            for (int u = 0; u < num_nodes; u++) {
+                for (auto [edge, forward] : adj_list.at(u)) {
+                    auto [cost, capacity] = residual_arc(edge, forward);
+                    int v { arc_sink(edge, forward) };
+                    if (capacity > 0 && -potential.at(u) + cost < -potential.at(v)) {
+                        potential.at(v) = potential.at(u) - cost;
+                        updated = true;
+                    }
+                }
+            }
+        }
+        if (updated) {
+            throw std::invalid_argument("The graph has a negative cycle, Successive Shortest Path cannot be applied");
+        }
+
+        int total_imbalance {};
+        for (int u = 0; u < num_nodes; u++) {
+            total_imbalance += std::max(imbalance->at(u), 0);
+        }
+
+        std::vector<int> distance(num_nodes);
+        std::vector<std::pair<int, bool>> parent(num_nodes);
+        while (total_imbalance > 0) {
+            // Dijkstra on the reduced costs from all the nodes with imbalance > 0,
+            // until the nearest node with imbalance < 0 is reached
+            std::fill(distance.begin(), distance.end(), INF);
+            std::fill(parent.begin(), parent.end(), std::make_pair(-1, true));
+            std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> queue;
+            for (int u = 0; u < num_nodes; u++) {
+                if (imbalance->at(u) > 0) {
+                    distance.at(u) = 0;
+                    queue.emplace(0, u);
+                }
+            }
+
+            int target { -1 };
+            while (!queue.empty()) {
+                auto [d, u] = queue.top();
+                queue.pop();
+
+                if (d > distance.at(u)) {
+                    continue;
+                }
+                if (imbalance->at(u) < 0) {
+                    target = u;
+                    break;
+                }
+
+                for (auto [edge, forward] : adj_list.at(u)) {
+                    auto [cost, capacity] = residual_arc(edge, forward);
+                    int v { arc_sink(edge, forward) };
+                    int reduced_cost { cost - potential.at(u) + potential.at(v) };
+                    if (capacity > 0 && d + reduced_cost < distance.at(v)) {
+                        distance.at(v) = d + reduced_cost;
+                        parent.at(v) = { edge, forward };
+                        queue.emplace(distance.at(v), v);
+                    }
+                }
+            }
+
+            if (target == -1) {
+                throw std::runtime_error("Max flow not reached");
+            }
+
+            // update node potentials, the distances are capped to the distance of the target
+            for (int u = 0; u < num_nodes; u++) {
+                potential.at(u) -= std::min(distance.at(u), distance.at(target));
+            }
+
+            // get the path from the target back to its start node and the flow that can be sent
+            std::vector<std::pair<int, bool>> path;
+            int augment_flow { -imbalance->at(target) };
+            int node { target };
+            while (parent.at(node).first != -1) {
+                auto [edge, forward] = parent.at(node);
+                path.emplace_back(edge, forward);
+                augment_flow = std::min(augment_flow, residual_arc(edge, forward).second);
+                node = forward ? edges.at(edge).getSource() : edges.at(edge).getSink();
+            }
+            augment_flow = std::min(augment_flow, imbalance->at(node));
+
+            // send the flow in the path (at most up to the next breakpoint of each edge, so the costs do not change)
+            int path_cost {};
+            for (auto [edge, forward] : path) {
+                path_cost += residual_arc(edge, forward).first;
+                flow.at(edge) += forward ? augment_flow : -augment_flow;
+            }
+            utils::ProgressReporter::Augment(augment_flow, augment_flow * path_cost);
+            imbalance->at(node) -= augment_flow;
+            imbalance->at(target) += augment_flow;
+            total_imbalance -= augment_flow;
+        }
+
+        // get the optimal graph, the lower bound is part of the flow
+        auto optimal_graph = std::make_shared<data_structures::Graph>(num_nodes, graph->isMultigraph(), graph->getMemoryResource());
+        for (int i = 0; i < static_cast<int>(edges.size()); i++) {
+            auto edge = edges.at(i);
+            edge.setCapacity(flow.at(i));
+            edge.setLowerBound(0);
+            optimal_graph->addEdge(edge, graph->getCostSegments(edge.getId()));
+        }
+
+        int minimum_cost { MinimumCostFlowAlgorithms::getMinimumCost(optimal_graph) };
+        auto edge_flow = utils::GraphUtils::GetEdgeFlow(optimal_graph, graph);
+
+        return std::make_shared<dto::FlowResult>(optimal_graph, minimum_cost, edge_flow);
+    }
+
+    std::shared_ptr<dto::FlowResult> MinimumCostFlowAlgorithms::SolveByComponents(const std::shared_ptr<data_structures::Graph>& graph,
+        int source, int sink,
+        const std::function<std::shared_ptr<dto::FlowResult>(const std::shared_ptr<data_structures::Graph>&, int, int)>& algorithm) {
+
+        int num_nodes { graph->getNumNodes() };
+        auto component = GraphBaseAlgorithms::WeaklyConnectedComponents(graph);
+        int num_components { *std::max_element(component->begin(), component->end()) + 1 };
+
+        // nothing to split
+        if (num_components == 1) {
+            return algorithm(graph, source, sink);
+        }
+
+        // nodes of each component (the index of a node in its component is its node in the subproblem)
+        std::vector<std::vector<int>> nodes(num_components);
+        std::vector<int> local_node(num_nodes);
+        for (int u = 0; u < num_nodes; u++) {
+            local_node.at(u) = static_cast<int>(nodes.at(component->at(u)).size());
+            nodes.at(component->at(u)).push_back(u);
+        }
+
+        // a component can have flow without the terminals if it has lower bounds or a negative cost
+        // (a negative cycle is cancelled even if the source cannot reach it, see CycleCancelling())
+        std::vector<bool> has_circulation(num_components, false);
+        for (int u = 0; u < num_nodes; u++) {
+            for (auto e : *graph->getNodeAdjList(u)) {
+                if (e.getLowerBound() || e.getCost() < 0) {
+                    has_circulation.at(component->at(u)) = true;
+                }
+            }
+        }
+
+        // the components that can have flow: the one with both source and sink and the ones with a circulation
+        bool terminals_connected { component->at(source) == component->at(sink) };
+        std::vector<int> subproblems;
+        for (int c = 0; c < num_components; c++) {
+            if ((terminals_connected && c == component->at(source)) || has_circulation.at(c)) {
+                subproblems.push_back(c);
+            }
+        }
+
+        // solve a component: the graph of the component with its nodes renumbered, the components without both
+        // source and sink get two isolated artificial terminals (no flow between them, only the circulation)
+        auto solve_component = [&](int c, std::pmr::memory_resource* resource) {
+            int component_nodes { static_cast<int>(nodes.at(c).size()) };
+            bool has_terminals { terminals_connected && c == component->at(source) };
+            auto component_graph = std::make_shared<data_structures::Graph>(component_nodes + (has_terminals ? 0 : 2), graph->isMultigraph(), resource);
+
+            // the edges keep their ids, so the results can be merged by id
+            for (int u : nodes.at(c)) {
+                for (auto e : *graph->getNodeAdjList(u)) {
+                    data_structures::Edge edge(local_node.at(u), local_node.at(e.getSink()), e.getCapacity(), e.getCost(), e.getLowerBound());
+                    edge.setId(e.getId());
+                    edge.setUndirected(e.isUndirected());
+                    component_graph->addEdge(edge, graph->getCostSegments(e.getId()));
+                }
+            }
+
+            for (int u : nodes.at(c)) {
+                if (graph->hasNodeCapacity(u)) {
+                    component_graph->setNodeCapacity(local_node.at(u), graph->getNodeCapacity(u));
+                }
+            }
+
+            if (has_terminals) {
+                return algorithm(component_graph, local_node.at(source), local_node.at(sink));
+            }
+            return algorithm(component_graph, component_nodes, component_nodes + 1);
+        };
+
+        // solve the subproblems in parallel, each thread takes the next subproblem not solved yet
+        int num_subproblems { static_cast<int>(subproblems.size()) };
+        // (the calling thread is a worker too, also without subproblems)
+        int num_threads { std::max(std::min(static_cast<int>(std::thread::hardware_concurrency()), num_subproblems), 1) };
+
+        // the resource of the graph is used only by the calling thread (it does not need to be thread-safe):
+        // each thread builds the graphs of its subproblems in its own pool, the pools take their memory
+        // from a synchronized pool and they are released after the results are merged
+        std::pmr::synchronized_pool_resource shared_pool(std::pmr::new_delete_resource());
+        std::vector<std::unique_ptr<std::pmr::unsynchronized_pool_resource>> thread_pools;
+        for (int i = 0; i < num_threads; i++) {
+            thread_pools.push_back(std::make_unique<std::pmr::unsynchronized_pool_resource>(&shared_pool));
+        }
+
+        std::vector<std::shared_ptr<dto::FlowResult>> results(num_subproblems);
+        std::vector<std::exception_ptr> errors(num_subproblems);
+        std::atomic<int> next_subproblem { 0 };
+
+        // the progress of every thread goes to the reporter of the calling thread
+        auto* reporter = utils::ProgressReporter::Current();
+        auto worker = [&](std::pmr::memory_resource* resource) {
+            utils::ProgressReporter thread_reporter(reporter);
+            for (int i = next_subproblem++; i < num_subproblems; i = next_subproblem++) {
+                try {
+                    results.at(i) = solve_component(subproblems.at(i), resource);
+                } catch (...) {
+                    errors.at(i) = std::current_exception();
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int i = 1; i < num_threads; i++) {
+            threads.emplace_back(worker, thread_pools.at(i).get());
+        }
+        worker(thread_pools.at(0).get());
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        // report the error of the first component that failed
+        for (auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        // merge the results, the dropped components have no flow
+        auto optimal_graph = std::make_shared<data_structures::Graph>(num_nodes, graph->isMultigraph(), graph->getMemoryResource());
+        auto potential = std::make_shared<std::vector<int>>(num_nodes, 0);
+        auto reduced_cost_graph = std::make_shared<data_structures::Graph>(num_nodes, graph->isMultigraph(), graph->getMemoryResource());
+        bool has_potentials { true };
+        int minimum_cost {};
+
+        // add the edge u -> v of a subproblem result graph to the graph of the whole problem
+        // (the edges keep their ids, so their cost segments are the ones of the graph)
+        auto add_edge = [&graph](const std::shared_ptr<data_structures::Graph>& merged_graph, int u, int v, const data_structures::Edge& e) {
+            data_structures::Edge edge(u, v, e.getCapacity(), e.getCost());
+            edge.setId(e.getId());
+            edge.setUndirected(e.isUndirected());
+            merged_graph->addEdge(edge, graph->getCostSegments(e.getId()));
+        };
+
+        std::vector<int> subproblem(num_components, -1);
+        for (int i = 0; i < num_subproblems; i++) {
+            subproblem.at(subproblems.at(i)) = i;
+            minimum_cost += results.at(i)->getFlow();
+            has_potentials = has_potentials && !results.at(i)->getPotential()->empty() && results.at(i)->getReducedCostGraph();
+        }
+
+        // the merged cost must be the cost of the whole graph solved at once (audit build only, see consts::audit)
+        if constexpr (consts::audit) {
+            utils::ProgressReporter::Pause pause;
+            if (algorithm(graph, source, sink)->getFlow() != minimum_cost) {
+                throw std::runtime_error("The merged cost of the components differs from the cost of the whole graph");
+            }
+        }
+
+        for (int c = 0; c < num_components; c++) {
+            if (subproblem.at(c) == -1) {
+                for (int u : nodes.at(c)) {
+                    for (auto e : *graph->getNodeAdjList(u)) {
+                        data_structures::Edge edge(u, e.getSink(), 0, e.getCost());
+                        edge.setId(e.getId());
+                        edge.setUndirected(e.isUndirected());
+                        optimal_graph->addEdge(edge, graph->getCostSegments(e.getId()));
+                        add_edge(reduced_cost_graph, u, e.getSink(), edge);
+                    }
+                }
+                continue;
+            }
+
+            auto result = results.at(subproblem.at(c));
+            int component_nodes { static_cast<int>(nodes.at(c).size()) };
+            for (int u = 0; u < component_nodes; u++) {
+                for (auto e : *result->getGraph()->getNodeAdjList(u)) {
+                    add_edge(optimal_graph, nodes.at(c).at(u), nodes.at(c).at(e.getSink()), e);
+                }
+                if (has_potentials) {
+                    potential->at(nodes.at(c).at(u)) = result->getPotential()->at(u);
+                    for (auto e : *result->getReducedCostGraph()->getNodeAdjList(u)) {
+                        add_edge(reduced_cost_graph, nodes.at(c).at(u), nodes.at(c).at(e.getSink()), e);
+                    }
+                }
+            }
+        }
+
+        auto edge_flow = utils::GraphUtils::GetEdgeFlow(optimal_graph, graph);
+        if (!has_potentials) {
+            return std::make_shared<dto::FlowResult>(optimal_graph, minimum_cost, edge_flow);
+        }
+        return std::make_shared<dto::FlowResult>(optimal_graph, minimum_cost, edge_flow, potential, reduced_cost_graph);
+    }
+
+    std::shared_ptr<dto::FlowResult> MinimumCostFlowAlgorithms::SolveReordered(const std::shared_ptr<data_structures::Graph>& graph,
+        int source, int sink,
+        const std::function<std::shared_ptr<dto::FlowResult>(const std::shared_ptr<data_structures::Graph>&, int, int)>& algorithm,
+        NodeOrder order) {
+
+        int num_nodes { graph->getNumNodes() };
+        if (sink < 0 || sink >= num_nodes) {
+            throw std::invalid_argument("The sink must be a node of the graph");
+        }
+
+        // the node nodes->at(i) becomes i
+        auto nodes = GraphBaseAlgorithms::NodeOrdering(graph, source, order);
+        std::vector<int> new_node(num_nodes);
+        for (int i = 0; i < num_nodes; i++) {
+            new_node.at(nodes->at(i)) = i;
+        }
+
+        auto result = algorithm(utils::GraphUtils::GetRenumberedGraph(graph, new_node), new_node.at(source), new_node.at(sink));
+
+        // translate the result back, the node i becomes nodes->at(i)
+        auto optimal_graph = utils::GraphUtils::GetRenumberedGraph(result->getGraph(), *nodes);
+        auto edge_flow = result->getEdgeFlow()->empty() ? utils::GraphUtils::GetEdgeFlow(optimal_graph, graph) : result->getEdgeFlow();
+        if (result->getPotential()->empty() || !result->getReducedCostGraph()) {
+            return std::make_shared<dto::FlowResult>(optimal_graph, result->getFlow(), edge_flow);
+        }
+
+        auto potential = std::make_shared<std::vector<int>>(num_nodes, 0);
+        for (int i = 0; i < num_nodes; i++) {
+            potential->at(nodes->at(i)) = result->getPotential()->at(i);
+        }
+        auto reduced_cost_graph = utils::GraphUtils::GetRenumberedGraph(result->getReducedCostGraph(), *nodes);
+
+        return std::make_shared<dto::FlowResult>(optimal_graph, result->getFlow(), edge_flow, potential, reduced_cost_graph);
+    }
+
+    std::shared_ptr<dto::SensitivityReport> MinimumCostFlowAlgorithms::CostSensitivity(const std::shared_ptr<data_structures::Graph>& graph,
+        const std::shared_ptr<dto::FlowResult>& flow_result) {
+
+        MinimumCostFlowAlgorithms::checkLinearCosts(graph);
+        if (utils::GraphUtils::HasUndirectedEdges(graph) || !graph->getNodeCapacities()->empty()) {
+            throw std::invalid_argument("The cost sensitivity analysis does not support undirected edges and node capacities");
+        }
+
+        const int INF { std::numeric_limits<int>::max() };
+        int num_nodes { graph->getNumNodes() };
+        // flow of each edge id (parallel edges have different ids)
+        auto optimal_edge_flow = flow_result->getEdgeFlow();
+        if (optimal_edge_flow->empty()) {
+            optimal_edge_flow = utils::GraphUtils::GetEdgeFlow(flow_result->getGraph(), graph);
+        }
+
+        // residual arc: sink, cost, index of the original edge
+        struct ResidualArc {
+            int sink;
+            int cost;
+            int edge;
+        };
+
+        // implicit residual graph of the optimal flow (anti-parallel edges are kept as separate arcs)
+        std::vector<data_structures::Edge> edges;
+        std::vector<int> edge_flow;
+        std::vector<std::vector<ResidualArc>> residual(num_nodes);
+        for (int u = 0; u < num_nodes; u++) {
+            for (auto edge: *graph->getNodeAdjList(u)) {
+                int v { edge.getSink() };
+                int flow { edge.getId() < static_cast<int>(optimal_edge_flow->size()) ? optimal_edge_flow->at(edge.getId()) : 0 };
+                int index { static_cast<int>(edges.size()) };
+
+                if (flow < edge.getCapacity()) {
+                    residual.at(u).push_back({ v, edge.getCost(), index });
+                }
+                if (flow > edge.getLowerBound()) {
+                    residual.at(v).push_back({ u, -edge.getCost(), index });
+                }
+
+                edges.push_back(edge);
+                edge_flow.push_back(flow);
+            }
+        }
+
+        auto potential = flow_result->getPotential();
+        if (potential->empty()) {
+            // Bellman-Ford from a virtual node connected to every node with cost 0,
+            // the residual graph of an optimal flow has no negative cycles
+            std::vector<int> distance(num_nodes, 0);
+            bool updated { true };
+            for (int i = 0; i < num_nodes && updated; i++) {
+                updated = false;
+                for (int u = 0; u < num_nodes; u++) {
+                    for (auto& arc: residual.at(u)) {
+                        if (distance.at(u) + arc.cost < distance.at(arc.sink)) {
+                            distance.at(arc.sink) = distance.at(u) + arc.cost;
+                            updated = true;
+                        }
+                    }
+                }
+            }
+            if (updated) {
+                throw std::invalid_argument("The flow is not optimal, the residual graph has a negative cycle");
+            }
+
+            potential = std::make_shared<std::vector<int>>(num_nodes);
+            std::transform(distance.begin(), distance.end(), potential->begin(), [](int d) { return -d; });
+        }
+
+        // reduced costs of the residual arcs
+        for (int u = 0; u < num_nodes; u++) {
+            for (auto& arc: residual.at(u)) {
+                arc.cost += -potential->at(u) + potential->at(arc.sink);
+                if (arc.cost < 0) {
+                    throw std::invalid_argument("The flow is not optimal, the residual graph has a negative reduced cost");
+                }
+            }
+        }
+
+        // shortest path distance from start to target on the reduced costs, without the arcs of the excluded edge
+        auto shortest_distance = [&residual, num_nodes, INF](int start, int target, int excluded_edge) {
+            std::vector<int> distance(num_nodes, INF);
+            std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> queue;
+            distance.at(start) = 0;
+            queue.emplace(0, start);
+
+            while (!queue.empty()) {
+                auto [d, u] = queue.top();
+                queue.pop();
+
+                if (u == target) {
+                    return d;
+                }
+                if (d > distance.at(u)) {
+                    continue;
+                }
+
+                for (auto& arc: residual.at(u)) {
+                    if (arc.edge != excluded_edge && d + arc.cost < distance.at(arc.sink)) {
+                        distance.at(arc.sink) = d + arc.cost;
+                        queue.emplace(distance.at(arc.sink), arc.sink);
+                    }
+                }
+            }
+
+            return INF;
+        };
+
+        auto sensitivity = std::make_shared<std::vector<dto::EdgeSensitivity>>();
+        for (int i = 0; i < static_cast<int>(edges.size()); i++) {
+            auto& edge = edges.at(i);
+            int u { edge.getSource() };
+            int v { edge.getSink() };
+            int flow { edge_flow.at(i) };
+            int reduced_cost { edge.getCost() - potential->at(u) + potential->at(v) };
+
+            // the cost can decrease until the cycle u -> v -> ... -> u gets negative
+            int min_cost { std::numeric_limits<int>::min() };
+            if (flow < edge.getCapacity()) {
+                int distance { shortest_distance(v, u, i) };
+                if (distance != INF) {
+                    min_cost = edge.getCost() - reduced_cost - distance;
+                }
+            }
+
+            // the cost can increase until the cycle v -> u -> ... -> v gets negative
+            int max_cost { INF };
+            if (flow > edge.getLowerBound()) {
+                int distance { shortest_distance(u, v, i) };
+                if (distance != INF) {
+                    max_cost = edge.getCost() - reduced_cost + distance;
+                }
+            }
+
+            sensitivity->emplace_back(edge.getId(), u, v, flow, edge.getCost(), reduced_cost, min_cost, max_cost);
+        }
+
+        return std::make_shared<dto::SensitivityReport>(potential, sensitivity);
+    }
+
+    void MinimumCostFlowAlgorithms::checkLinearCosts(const std::shared_ptr<data_structures::Graph>& graph) {
+        if (utils::GraphUtils::HasConvexCosts(graph)) {
+            throw std::invalid_argument("The graph has convex piecewise-linear costs, use the convex cost algorithm");
+        }
+    }
+
+    std::shared_ptr<dto::FlowResult> MinimumCostFlowAlgorithms::solveExpanded(const std::shared_ptr<data_structures::Graph>& graph,
+        int source, int sink,
+        const std::function<std::shared_ptr<dto::FlowResult>(const std::shared_ptr<data_structures::Graph>&, int, int)>& algorithm) {
+
+        int num_nodes { graph->getNumNodes() };
+        int num_edge_ids { graph->getNumEdgeIds() };
+
+        // the edges leaving a node with capacity leave from its exit node
+        std::vector<int> exit_node(num_nodes);
+        std::iota(exit_node.begin(), exit_node.end(), 0);
+        int num_expanded_nodes { num_nodes };
+        for (auto& it : *graph->getNodeCapacities()) {
+            exit_node.at(it.first) = num_expanded_nodes++;
+        }
+
+        auto expanded_graph = std::make_shared<data_structures::Graph>(num_expanded_nodes, true, graph->getMemoryResource());
+        auto add_edge = [&graph, &expanded_graph, &exit_node](int u, int v, const data_structures::Edge& e, int id) {
+            data_structures::Edge edge(exit_node.at(u), v, e.getCapacity(), e.getCost(), e.getLowerBound());
+            edge.setId(id);
+            expanded_graph->addEdge(edge, graph->getCostSegments(e.getId()));
+        };
+
+        // the directed edge sink -> source of the undirected edge with id i gets the id num_edge_ids + i
+        for (int u = 0; u < num_nodes; u++) {
+            for (auto e : *graph->getNodeAdjList(u)) {
+                add_edge(u, e.getSink(), e, e.getId());
+                if (e.isUndirected()) {
+                    add_edge(e.getSink(), u, e, num_edge_ids + e.getId());
+                }
+            }
+        }
+
+        // the edge entry -> exit of a node with capacity gets the id 2 * num_edge_ids + node
+        for (auto& [node, capacity] : *graph->getNodeCapacities()) {
+            data_structures::Edge edge(node, exit_node.at(node), capacity, 0);
+            edge.setId(2 * num_edge_ids + node);
+            expanded_graph->addEdge(edge);
+        }
+
+        // the flow reaches the sink when it leaves its exit node
+        auto result = algorithm(expanded_graph, source, exit_node.at(sink));
+        auto expanded_flow = utils::GraphUtils::GetEdgeFlow(result->getGraph(), expanded_graph);
+
+        // merge the flows of the two directed edges of each undirected edge
+        auto optimal_graph = std::make_shared<data_structures::Graph>(num_nodes, graph->isMultigraph(), graph->getMemoryResource());
+        for (int u = 0; u < num_nodes; u++) {
+            for (auto e : *graph->getNodeAdjList(u)) {
+                int flow { expanded_flow->at(e.getId()) };
+                if (e.isUndirected()) {
+                    flow -= expanded_flow->at(num_edge_ids + e.getId());
+                }
+
+                if (flow < 0) {
+                    data_structures::Edge reverse_edge(e.getSink(), u, -flow, e.getCost());
+                    reverse_edge.setId(e.getId());
+                    reverse_edge.setUndirected(true);
+                    optimal_graph->addEdge(reverse_edge);
+                } else {
+                    e.setCapacity(flow);
+                    e.setLowerBound(0);
+                    optimal_graph->addEdge(e, graph->getCostSegments(e.getId()));
+                }
+            }
         }
 
-        auto optimal_graph = utils::GraphUtils::GetOptimalGraph(residual_graph, graph);
         int minimum_cost { MinimumCostFlowAlgorithms::getMinimumCost(optimal_graph) };
+        auto edge_flow = utils::GraphUtils::GetEdgeFlow(optimal_graph, graph);
+
+        // the entry and the exit of a node with capacity have different potentials, they are not returned
+        if (result->getPotential()->empty() || !graph->getNodeCapacities()->empty()) {
+            return std::make_shared<dto::FlowResult>(optimal_graph, minimum_cost, edge_flow);
+        }
+        auto reduced_cost_graph = MinimumCostFlowAlgorithms::getReducedCostGraph(optimal_graph, result->getPotential());
+        return std::make_shared<dto::FlowResult>(optimal_graph, minimum_cost, edge_flow, result->getPotential(), reduced_cost_graph);
+    }
+
+    std::shared_ptr<std::vector<int>> MinimumCostFlowAlgorithms::getNodePotentials(const std::shared_ptr<data_structures::Graph>& graph,
+        const std::vector<int>& potential, int source) {
+        auto node_potential = std::make_shared<std::vector<int>>(graph->getNumNodes());
+
+        // the potentials are defined up to a constant, the source gets potential 0
+        for (int u = 0; u < graph->getNumNodes(); u++) {
+            node_potential->at(u) = potential.at(u) - potential.at(source);
+        }
+
+        return node_potential;
+    }
 
-        return std::make_shared<dto::FlowResult>(optimal_graph, minimum_cost);        
+    std::shared_ptr<data_structures::Graph> MinimumCostFlowAlgorithms::getReducedCostGraph(const std::shared_ptr<data_structures::Graph>& optimal_graph,
+        const std::shared_ptr<std::vector<int>>& potential) {
+        auto reduced_cost_graph = std::make_shared<data_structures::Graph>(optimal_graph);
+
+        // update the edges of the copy in place (parallel edges can have different costs)
+        for (int u = 0; u < reduced_cost_graph->getNumNodes(); u++) {
+            auto adj_list = reduced_cost_graph->getMutableNodeAdjList(u);
+            for (auto& edge: *adj_list) {
+                edge.setCost(edge.getCost() - potential->at(u) + potential->at(edge.getSink()));
+            }
+        }
+
+        return reduced_cost_graph;
+    }
+
+    std::vector<int> MinimumCostFlowAlgorithms::getInitialPotentials(const std::shared_ptr<data_structures::Graph>& residual_graph) {
+        std::vector<int> nodes(residual_graph->getNumNodes());
+        std::iota(nodes.begin(), nodes.end(), 0);
+
+        auto bellman_ford_result = GraphBaseAlgorithms::FindNegativeCycle(residual_graph, nodes);
+        if (bellman_ford_result->hasNegativeCycle()) {
+            throw std::invalid_argument("The graph has a negative cycle, Successive Shortest Path cannot be applied");
+        }
+
+        std::vector<int> potential(nodes.size());
+        auto distance = bellman_ford_result->getDistance();
+        std::transform(distance->begin(), distance->end(), potential.begin(), std::negate<>());
+
+        return potential;
+    }
+
+    void MinimumCostFlowAlgorithms::updateReducedCosts(const std::shared_ptr<data_structures::Graph>& residual_graph,
+        const std::shared_ptr<std::vector<int>>& distance, int target, std::vector<int>& potential) {
+        int num_nodes { residual_graph->getNumNodes() };
+        int max_distance { distance->at(target) };
+
+        // cap the distances to the distance of the target, the nodes farther than the target
+        // (or not reachable) are treated as if they were at the same distance of the target
+        std::vector<int> capped_distance(num_nodes);
+        for (int u = 0; u < num_nodes; u++) {
+            capped_distance.at(u) = std::min(distance->at(u), max_distance);
+            potential.at(u) -= capped_distance.at(u);
+        }
+
+        // the edges are updated in place (the residual graph has no parallel edges)
+        for (int u = 0; u < num_nodes; u++) {
+            for (auto& edge: *residual_graph->getMutableNodeAdjList(u)) {
+                edge.setCost(edge.getCost() + capped_distance.at(u) - capped_distance.at(edge.getSink()));
+            }
+        }
     }
 
     int MinimumCostFlowAlgorithms::getMinimumCost(const std::shared_ptr<data_structures::Graph>& graph) {
@@ -269,7 +1134,7 @@ namespace algorithms {
         // compute the minimum cost using the optimal graph
         for (int u = 0; u < graph->getNumNodes(); u++) {
             for (auto edge: *graph->getNodeAdjList(u)) {
-                minimum_cost +=  edge.getCost() * edge.getCapacity();
+                minimum_cost += graph->getFlowCost(edge, edge.getCapacity());
             }
         }
 
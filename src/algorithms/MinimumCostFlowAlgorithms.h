@@ -2,9 +2,12 @@
 #define MINIMUM_COST_FLOWS_PROBLEM_MINIMUMCOSTFLOWALGORITHMS_H
 
 #include "dto/flowResult/FlowResult.h"
+#include "dto/sensitivityReport/SensitivityReport.h"
 #include "data_structures/graph/Graph.h"
+#include "algorithms/GraphBaseAlgorithms.h"
 
 #include <memory>
+#include <functional>
 
 namespace algorithms
 {
@@ -13,6 +16,7 @@ namespace algorithms
      * - Cycle-Cancelling
      * - Successive Shortest Path
      * - Primal-Dual
+     * - Convex cost Successive Shortest Path
      */
     class MinimumCostFlowAlgorithms
     {
@@ -23,6 +27,8 @@ namespace algorithms
          * The cycle-canceling algorithm is one of the earliest algorithms to solve the minimum cost flow problem.
          * This algorithm maintains a feasible solution x in the network G and proceeds by augmenting flows along negative
          * cost directed cycles in the residual network G(x) and thereby canceling them
+         * The negative cycles are searched only inside the non-trivial strongly connected components of the
+         * residual graph, and after each cancellation only the components of the cancelled cycle are updated.
          * Return the residual graph and the minimum weight flow of the path between source and sink.
          *
          * (see: https://complex-systems-ai.com/en/maximum-flow-problem/cycle-canceling-algorithm/)
@@ -48,6 +54,10 @@ namespace algorithms
          * a node s with excess supply and a node t with unfulfilled demand and sends flow
          * from s to t along a shortest path in the residual network. The algorithm terminates
          * when the current solution satisfies all the mass balance constraints.
+         * The shortest path tree is not computed from scratch after each augmentation: only the subtrees below
+         * the saturated edges of the path are repaired (see DynamicShortestPaths.h). The residual graph keeps the original costs
+         * and the reduced costs are evaluated from the node potentials, so no edge is rewritten after an augmentation.
+         * The dense graphs are solved on the dense matrices with the array version of Dijkstra (see DenseGraph.h).
          *
          * (see: https://www.topcoder.com/thrive/articles/Minimum%20Cost%20Flow%20Part%20Two:%20Algorithms)
          *
@@ -61,7 +71,7 @@ namespace algorithms
          * @param source the source node
          * @param sink   the sink node
          *
-         * @return the residual graph and the minimum weight flow
+         * @return the optimal graph, the minimum weight flow, the node potentials and the reduced costs
          */
         static std::shared_ptr<dto::FlowResult> SuccessiveShortestPath(const std::shared_ptr<data_structures::Graph> &graph, int source, int sink);
 
@@ -72,13 +82,217 @@ namespace algorithms
          * @param source the source node
          * @param sink   the sink node
          *
-         * @return the minimum weight flow
+         * @return the optimal graph, the minimum weight flow, the node potentials and the reduced costs
          */
         static std::shared_ptr<dto::FlowResult> PrimalDual(const std::shared_ptr<data_structures::Graph> &graph, int source, int sink);
 
+        /**
+         * Successive Shortest Path algorithm for convex piecewise-linear costs.
+         * The edges with cost segments (see Edge.h) are handled directly, without splitting them into one edge
+         * per segment: the residual edge u -> v costs the cost of the segment of the next unit of flow and its
+         * residual capacity ends at the next breakpoint, the residual edge v -> u costs minus the cost of the segment
+         * of the last unit of flow. Since the cost is convex, the reduced costs stay non-negative after each
+         * augmentation and the shortest paths are computed with Dijkstra (binary heap) on the reduced costs.
+         * The edges with linear cost are handled as edges with only one segment.
+         *
+         * (see: Ahuja, Magnanti, Orlin - Network Flows, chapter 14.2)
+         *
+         * V: number of nodes
+         * E: number of edges
+         * B: total number of segments
+         * U: maximum capacity
+         * Time complexity: O((V*U + B) * E * log(V))
+         *
+         * @param graph  the graph to solve
+         * @param source the source node
+         * @param sink   the sink node
+         *
+         * @return the optimal graph (flow as capacity of each edge) and the minimum cost of the maximum flow
+         */
+        static std::shared_ptr<dto::FlowResult> ConvexCostFlow(const std::shared_ptr<data_structures::Graph> &graph, int source, int sink);
+
+        /**
+         * Solve a minimum cost flow problem splitting it into its weakly connected components.
+         * The components are independent subproblems: the component with the source and the sink is solved with them,
+         * the other components with lower bounds or negative costs are solved as circulations (using isolated
+         * artificial terminals), and the other components are dropped (without terminals, lower bounds and negative
+         * costs their optimal flow is zero). So the result is the one of the algorithm applied to the whole graph.
+         * The subproblems are solved in parallel (at most one thread per hardware thread) and their results
+         * are merged into the result of the whole graph (optimal graph, minimum cost and, if all the subproblems
+         * return them, potentials and reduced costs).
+         * Each thread builds the graphs of its subproblems in its own memory pool: only the calling thread
+         * allocates from the memory resource of the graph (for the merged result), so it does not need to be thread-safe.
+         * If the graph is weakly connected, the algorithm is applied directly.
+         * In the audit build (see consts::audit) the whole graph is solved too, and its cost is checked against the merged one.
+         *
+         * (see: https://en.wikipedia.org/wiki/Component_(graph_theory))
+         *
+         * @param graph     the graph to solve
+         * @param source    the source node
+         * @param sink      the sink node
+         * @param algorithm the minimum cost flow algorithm used for each component (e.g. MinimumCostFlowAlgorithms::PrimalDual)
+         *
+         * @return the optimal graph and the minimum weight flow of the whole graph
+         *
+         * @throws runtime_error in the audit build, if the merged cost differs from the cost of the whole graph
+         */
+        static std::shared_ptr<dto::FlowResult> SolveByComponents(const std::shared_ptr<data_structures::Graph> &graph, int source, int sink,
+            const std::function<std::shared_ptr<dto::FlowResult>(const std::shared_ptr<data_structures::Graph> &, int, int)> &algorithm);
+
+        /**
+         * Solve a minimum cost flow problem on a copy of the graph with the nodes renumbered for locality
+         * (see GraphBaseAlgorithms::NodeOrdering()): the nodes close in the graph get close ids, so the traversals
+         * of the solver (BFS, Dijkstra, Bellman-Ford) read distances, parents and adjacent lists close in memory.
+         * The result is translated back to the ids of the graph (optimal graph, potentials and reduced costs),
+         * the edges keep their ids so the flow of each edge does not change.
+         * It can be combined with SolveByComponents() (e.g. passing a lambda calling it as algorithm).
+         *
+         * V: number of nodes
+         * E: number of edges
+         * Time complexity: O(V + E * log(V)) plus the time of the algorithm
+         *
+         * @param graph     the graph to solve
+         * @param source    the source node
+         * @param sink      the sink node
+         * @param algorithm the minimum cost flow algorithm (e.g. MinimumCostFlowAlgorithms::PrimalDual)
+         * @param order     the order of the renumbered nodes
+         *
+         * @return the optimal graph and the minimum weight flow of the graph
+         *
+         * @throws invalid_argument if the source or the sink is not a node of the graph
+         */
+        static std::shared_ptr<dto::FlowResult> SolveReordered(const std::shared_ptr<data_structures::Graph> &graph, int source, int sink,
+            const std::function<std::shared_ptr<dto::FlowResult>(const std::shared_ptr<data_structures::Graph> &, int, int)> &algorithm,
+            NodeOrder order);
+
+        /**
+         * Cost sensitivity analysis of an optimal flow.
+         * For each edge, it computes the reduced cost and the range of costs for which the flow stays optimal
+         * (all the other costs unchanged). Changing the cost of the edge u -> v by d changes by d the cost of the
+         * cycles of the residual graph that use the edge, so the flow stays optimal until one of them gets negative:
+         * - decreasing the cost (if flow < capacity) the cycle is u -> v followed by the shortest path v -> u
+         * - increasing the cost (if flow > lower bound) the cycle is v -> u followed by the shortest path u -> v
+         * The shortest paths are computed with Dijkstra on the reduced costs (non-negative in the residual graph
+         * of an optimal flow), without the edge itself.
+         * If the flow result does not contain the node potentials (e.g. Cycle-Cancelling), they are computed
+         * with Bellman-Ford on the residual graph.
+         *
+         * (see: https://en.wikipedia.org/wiki/Minimum-cost_flow_problem#Optimality_conditions)
+         *
+         * V: number of nodes
+         * E: number of edges
+         * Time complexity: O(V * E + E^2 * log(V))
+         *
+         * @param graph       the graph solved
+         * @param flow_result the result of a minimum cost flow algorithm on the graph
+         *
+         * @return the node potentials and the sensitivity of each edge
+         *
+         * @throws invalid_argument if the graph has convex costs, undirected edges or node capacities
+         */
+        static std::shared_ptr<dto::SensitivityReport> CostSensitivity(const std::shared_ptr<data_structures::Graph> &graph,
+                                                                       const std::shared_ptr<dto::FlowResult> &flow_result);
+
     private:
         /**
-         * Get the minimum cost of the residual graph after applying a minimum cost flow algorithm.
+         * Initial node potentials for the shortest path searches on a residual graph with negative costs.
+         * Bellman-Ford starts from a virtual source connected to every node with zero cost, so every node gets a
+         * distance (at most 0) and every negative cycle is found, reachable or not from the source.
+         * With the potential of each node equal to minus its distance the reduced costs
+         * (cost - potential[u] + potential[v]) are non-negative, as Dijkstra requires.
+         *
+         * V: number of nodes
+         * E: number of edges
+         * Time complexity: O(V * E)
+         *
+         * @param residual_graph the residual graph
+         *
+         * @return the potential of each node of the residual graph
+         *
+         * @throws invalid_argument if the residual graph has a negative cycle
+         */
+        static std::vector<int> getInitialPotentials(const std::shared_ptr<data_structures::Graph> &residual_graph);
+
+        /**
+         * Update the node potentials and the reduced costs of the residual graph using the distances
+         * found by the last shortest path search. The distances are capped to the distance of the target node,
+         * so the reduced costs stay non-negative also for the nodes farther than the target (or not reachable)
+         * and the edges of the shortest path to the target get zero reduced cost.
+         *
+         * @param residual_graph the residual graph with reduced costs
+         * @param distance       the distances from the start node of the shortest path search
+         * @param target         the end node of the shortest path
+         * @param potential      the potential of each node
+         */
+        static void updateReducedCosts(const std::shared_ptr<data_structures::Graph> &residual_graph,
+                                       const std::shared_ptr<std::vector<int>> &distance, int target, std::vector<int> &potential);
+
+        /**
+         * Check that all the edges of the graph have linear costs.
+         *
+         * @param graph the graph to check
+         *
+         * @throws invalid_argument if an edge has a convex piecewise-linear cost
+         */
+        static void checkLinearCosts(const std::shared_ptr<data_structures::Graph> &graph);
+
+        /**
+         * Solve a graph with undirected edges or node capacities on an equivalent directed graph.
+         * Each undirected edge is replaced with two opposite directed edges: in the residual graph the backward edge of
+         * an undirected edge with flow should cost minus the cost for the flow already sent and plus the cost for the rest
+         * of its capacity. Since the costs are positive, an optimal flow does not use both the directed edges, anyway
+         * the flow of the undirected edge is the difference of their flows.
+         * Each node with capacity is split into an entry node (the node itself) and an exit node, connected by an edge
+         * with the capacity of the node (the minimum cost flow algorithms work on the potentials of all the nodes).
+         * The potentials are returned only if there are no node capacities.
+         *
+         * @param graph     the graph with undirected edges or node capacities
+         * @param source    the source node
+         * @param sink      the sink node
+         * @param algorithm the minimum cost flow algorithm used on the directed graph
+         *
+         * @return the result with the original edges (an undirected edge follows the direction of its flow)
+         */
+        static std::shared_ptr<dto::FlowResult> solveExpanded(const std::shared_ptr<data_structures::Graph> &graph, int source, int sink,
+            const std::function<std::shared_ptr<dto::FlowResult>(const std::shared_ptr<data_structures::Graph> &, int, int)> &algorithm);
+
+        /**
+         * Successive Shortest Path algorithm on a dense graph (see DenseGraph::minCostMaxFlow()).
+         *
+         * @param graph  the graph to solve (see DenseGraph::IsSupported())
+         * @param source the source node
+         * @param sink   the sink node
+         *
+         * @return the optimal graph, the minimum weight flow, the node potentials and the reduced costs
+         */
+        static std::shared_ptr<dto::FlowResult> denseSuccessiveShortestPath(const std::shared_ptr<data_structures::Graph> &graph, int source, int sink);
+
+        /**
+         * Get the potentials of the nodes of the original graph, shifted so that the source has potential 0.
+         *
+         * @param graph     the original graph
+         * @param potential the potential of each node of the residual graph
+         * @param source    the source node
+         *
+         * @return the potential of each node of the original graph
+         */
+        static std::shared_ptr<std::vector<int>> getNodePotentials(const std::shared_ptr<data_structures::Graph> &graph,
+                                                                   const std::vector<int> &potential, int source);
+
+        /**
+         * Get the graph with the reduced cost (cost - potential[u] + potential[v]) of each edge of the optimal graph.
+         *
+         * @param optimal_graph the optimal graph
+         * @param potential     the potential of each node
+         *
+         * @return the graph with the flow as capacity and the reduced cost as cost of each edge
+         */
+        static std::shared_ptr<data_structures::Graph> getReducedCostGraph(const std::shared_ptr<data_structures::Graph> &optimal_graph,
+                                                                           const std::shared_ptr<std::vector<int>> &potential);
+
+        /**
+         * Get the minimum cost of the optimal graph after applying a minimum cost flow algorithm.
+         * The cost of the edges with cost segments is the cost of the segments filled by the flow.
          *
          * @param graph the graph from which to get the minimum cost
          *
@@ -7,6 +7,14 @@ namespace consts {
     
     // used to represent the source node parent
     inline constexpr int source_parent { -1 };
+
+    // true in the audit build (NETWORK_FLOWS_AUDIT defined): the unchecked accessors used by the solvers check their input too,
+    // and the solvers that split a problem check their result against the whole problem
+#ifdef NETWORK_FLOWS_AUDIT
+    inline constexpr bool audit { true };
+#else
+    inline constexpr bool audit { false };
+#endif
 }
 
 #endif //MINIMUM_COST_FLOWS_PROBLEM_CONSTS_H
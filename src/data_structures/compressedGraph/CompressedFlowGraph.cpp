@@ -0,0 +1,57 @@
+#include "CompressedFlowGraph.h"
+
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+namespace data_structures {
+    CompressedFlowGraph::CompressedFlowGraph(CompressedGraph graph) :
+        graph(std::move(graph)),
+        flow() {
+        if (!this->graph.isFlowSupported()) {
+            throw std::invalid_argument("The compressed graph cannot be solved, it may have lost lower bounds, "
+                                        "node capacities or undirected edges (compress the graph again)");
+        }
+        this->flow.assign(this->graph.getNumArcs(), 0);
+    }
+
+    int CompressedFlowGraph::getNumNodes() const {
+        return this->graph.getNumNodes();
+    }
+
+    int CompressedFlowGraph::getResidualCapacity(int source, int sink) const {
+        int residual_capacity {};
+        this->graph.forEachOutArc(source, [&](std::size_t arc, int v) {
+            if (v == sink) {
+                residual_capacity += this->graph.getCapacity(arc) - this->flow[arc];
+            }
+        });
+        this->graph.forEachInArc(source, [&](std::size_t arc, int u) {
+            if (u == sink) {
+                residual_capacity += this->flow[arc];
+            }
+        });
+        return residual_capacity;
+    }
+
+    void CompressedFlowGraph::push(int source, int sink, int flow) {
+        this->graph.forEachInArc(source, [&](std::size_t arc, int u) {
+            if (u == sink && flow > 0) {
+                int cancelled { std::min(flow, this->flow[arc]) };
+                this->flow[arc] -= cancelled;
+                flow -= cancelled;
+            }
+        });
+        this->graph.forEachOutArc(source, [&](std::size_t arc, int v) {
+            if (v == sink && flow > 0) {
+                int sent { std::min(flow, this->graph.getCapacity(arc) - this->flow[arc]) };
+                this->flow[arc] += sent;
+                flow -= sent;
+            }
+        });
+    }
+
+    int CompressedFlowGraph::getFlow(std::size_t arc) const {
+        return this->flow[arc];
+    }
+}
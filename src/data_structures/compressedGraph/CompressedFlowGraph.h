@@ -0,0 +1,99 @@
+#ifndef NETWORK_FLOWS_COMPRESSEDFLOWGRAPH_H
+#define NETWORK_FLOWS_COMPRESSEDFLOWGRAPH_H
+
+#include "data_structures/flowGraph/FlowGraph.h"
+#include "data_structures/compressedGraph/CompressedGraph.h"
+#include "utils/LargeArrays.h"
+
+#include <vector>
+#include <cstddef>
+
+namespace data_structures {
+    /**
+     * Residual network of a compressed graph as a FlowGraph, so the generic maximum flow algorithms
+     * (see FlowGraphAlgorithms.h) run on a compressed graph, also when it is memory-mapped from a file.
+     * The compressed graph is read-only: the flow of each arc is kept in RAM (4 bytes per arc), and the residual
+     * arcs are derived from it: u -> v for each arc u -> v not saturated and for each arc v -> u with flow.
+     * Only the compressed graphs of checked graphs can be solved (see CompressedGraph::isFlowSupported()).
+     * The flow of an undirected edge is on one of its two arcs, since the flow sent back is cancelled first (see push()).
+     */
+    class CompressedFlowGraph {
+        public:
+            /**
+             * Constructor, the flow starts at zero.
+             *
+             * @param graph the compressed graph (the copy shares its arrays)
+             *
+             * @throws invalid_argument if the compressed graph cannot be solved (see CompressedGraph::isFlowSupported())
+             */
+            explicit CompressedFlowGraph(CompressedGraph graph);
+
+            /**
+             * Get the number of nodes.
+             *
+             * @return the number of nodes
+             */
+            [[nodiscard]] int getNumNodes() const;
+
+            /**
+             * Visit each node reachable from the node with a forward or a backward residual arc
+             * (the arcs leaving the node, then the arcs entering it).
+             *
+             * @param node    the node
+             * @param visitor the function called with each node
+             */
+            template<typename Visitor>
+            void forEachResidualNeighbor(int node, Visitor&& visitor) const {
+                this->graph.forEachOutArc(node, [this, &visitor](std::size_t arc, int sink) {
+                    if (this->graph.getCapacity(arc) > this->flow[arc]) {
+                        visitor(sink);
+                    }
+                });
+                this->graph.forEachInArc(node, [this, &visitor](std::size_t arc, int source) {
+                    if (this->flow[arc] > 0) {
+                        visitor(source);
+                    }
+                });
+            }
+
+            /**
+             * Get the residual capacity from source to sink: the capacity left on the arcs source -> sink
+             * plus the flow of the arcs sink -> source.
+             *
+             * @param source the source node
+             * @param sink   the sink node
+             *
+             * @return the residual capacity
+             */
+            [[nodiscard]] int getResidualCapacity(int source, int sink) const;
+
+            /**
+             * Send flow from source to sink: the flow of the arcs sink -> source is cancelled first,
+             * the rest goes on the arcs source -> sink.
+             *
+             * @param source the source node
+             * @param sink   the sink node
+             * @param flow   the flow to send (at most the residual capacity)
+             */
+            void push(int source, int sink, int flow);
+
+            /**
+             * Get the flow of an arc.
+             *
+             * @param arc the index of the arc (see CompressedGraph::forEachOutArc())
+             *
+             * @return the flow of the arc
+             */
+            [[nodiscard]] int getFlow(std::size_t arc) const;
+
+        private:
+            CompressedGraph graph;
+
+            // flow of each arc, with the allocation policy of the large arrays
+            utils::LargeVector<int> flow;
+    };
+
+    static_assert(FlowGraph<CompressedFlowGraph>);
+}
+
+#endif //NETWORK_FLOWS_COMPRESSEDFLOWGRAPH_H
@@ -0,0 +1,263 @@
+#include "CompressedGraph.h"
+
+#include "utils/LargeArrays.h"
+
+#include <bit>
+#include <tuple>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace data_structures {
+    /*
+     * Layout of the image, in 64-bit words:
+     *  - header (header_words): magic, version, nodes, capacity bits, arcs, out bytes, in bytes, capacity words, flags
+     *    (first_version_header_words, without the flags, in the first version);
+     *  - first_out_arc, out_offset, first_in_arc, in_offset (nodes + 1 words each);
+     *  - capacities (capacity words, the last one is padding);
+     *  - the bytes of the arcs leaving the nodes, then the bytes of the arcs entering them (each padded to a word).
+     */
+
+    bool CompressedGraph::IsSupported(const std::shared_ptr<Graph>& graph) {
+        if (!graph->getNodeCapacities()->empty()) {
+            return false;
+        }
+
+        for (int u = 0; u < graph->getNumNodes(); u++) {
+            for (const auto& e : *graph->getNodeAdjList(u)) {
+                if (e.getLowerBound()) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    CompressedGraph::CompressedGraph(const std::shared_ptr<Graph>& graph) :
+        num_nodes(graph->getNumNodes()),
+        capacity_bits(0),
+        num_arcs(0),
+        image_words(0),
+        flags(0) {
+        if (!CompressedGraph::IsSupported(graph)) {
+            throw std::invalid_argument("The graph cannot be compressed");
+        }
+
+        std::size_t nodes { static_cast<std::size_t>(this->num_nodes) };
+        std::vector<std::uint64_t> first_out(nodes + 1, 0);
+        std::vector<std::uint64_t> out_positions(nodes + 1, 0);
+        std::vector<std::uint64_t> first_in(nodes + 1, 0);
+        std::vector<std::uint64_t> in_positions(nodes + 1, 0);
+
+        // the undirected edge u - v also gives the arc v -> u, stored with the arcs leaving v
+        std::vector<std::uint64_t> first_reverse(nodes + 1, 0);
+
+        // the capacities are packed with the bits of the maximum one
+        int max_capacity {};
+        for (int u = 0; u < this->num_nodes; u++) {
+            for (const auto& e : *graph->getNodeAdjList(u)) {
+                max_capacity = std::max(max_capacity, e.getCapacity());
+                first_in[e.getSink() + 1]++;
+                if (e.isUndirected()) {
+                    first_in[u + 1]++;
+                    first_reverse[e.getSink() + 1]++;
+                    this->num_arcs++;
+                }
+            }
+            this->num_arcs += graph->getNodeAdjList(u)->size();
+        }
+        for (std::size_t v = 0; v < nodes; v++) {
+            first_in[v + 1] += first_in[v];
+            first_reverse[v + 1] += first_reverse[v];
+        }
+
+        utils::LargeVector<std::tuple<int, int, int>> reverse_arcs(first_reverse[nodes]);
+        std::vector<std::uint64_t> next_reverse(first_reverse.begin(), first_reverse.end() - 1);
+        for (int u = 0; u < this->num_nodes; u++) {
+            for (const auto& e : *graph->getNodeAdjList(u)) {
+                if (e.isUndirected()) {
+                    reverse_arcs[next_reverse[e.getSink()]++] = { u, e.getCapacity(), e.getCost() };
+                }
+            }
+        }
+        this->capacity_bits = static_cast<int>(std::bit_width(static_cast<unsigned>(max_capacity)));
+        std::vector<std::uint64_t> packed_capacities((this->num_arcs * this->capacity_bits + 63) / 64 + 1, 0);
+
+        // the arcs entering each node are filled by increasing source, since the sources are visited in order
+        utils::LargeVector<std::pair<int, std::uint64_t>> in_arcs(this->num_arcs);
+        std::vector<std::uint64_t> next_in(first_in.begin(), first_in.end() - 1);
+
+        std::vector<std::uint8_t> out_stream;
+        std::vector<std::tuple<int, int, int>> arcs;
+        std::uint64_t arc {};
+        for (int u = 0; u < this->num_nodes; u++) {
+            first_out[u] = arc;
+            out_positions[u] = out_stream.size();
+
+            // sorted by sink, so the sinks are stored as small non-negative deltas
+            arcs.clear();
+            for (const auto& e : *graph->getNodeAdjList(u)) {
+                arcs.emplace_back(e.getSink(), e.getCapacity(), e.getCost());
+            }
+            arcs.insert(arcs.end(), reverse_arcs.begin() + first_reverse[u], reverse_arcs.begin() + first_reverse[u + 1]);
+            std::sort(arcs.begin(), arcs.end());
+
+            int previous_sink {};
+            for (auto [sink, capacity, cost] : arcs) {
+                CompressedGraph::WriteVarint(out_stream, static_cast<std::uint64_t>(sink - previous_sink));
+                CompressedGraph::WriteVarint(out_stream, (static_cast<std::uint32_t>(cost) << 1) ^ static_cast<std::uint32_t>(cost >> 31));
+                previous_sink = sink;
+                in_arcs[next_in[sink]++] = { u, arc };
+
+                std::size_t bit { arc * this->capacity_bits };
+                unsigned shift { static_cast<unsigned>(bit % 64) };
+                packed_capacities[bit / 64] |= static_cast<std::uint64_t>(capacity) << shift;
+                if (shift + this->capacity_bits > 64) {
+                    packed_capacities[bit / 64 + 1] |= static_cast<std::uint64_t>(capacity) >> (64 - shift);
+                }
+                arc++;
+            }
+        }
+        first_out[nodes] = arc;
+        out_positions[nodes] = out_stream.size();
+
+        std::vector<std::uint8_t> in_stream;
+        for (std::size_t v = 0; v < nodes; v++) {
+            in_positions[v] = in_stream.size();
+            int previous_source {};
+            for (std::uint64_t i = first_in[v]; i < first_in[v + 1]; i++) {
+                CompressedGraph::WriteVarint(in_stream, static_cast<std::uint64_t>(in_arcs[i].first - previous_source));
+                CompressedGraph::WriteVarint(in_stream, in_arcs[i].second);
+                previous_source = in_arcs[i].first;
+            }
+        }
+        in_positions[nodes] = in_stream.size();
+
+        // copy the header and the arrays in the image, allocated once with the policy of the large arrays
+        std::size_t out_words { (out_stream.size() + 7) / 8 };
+        std::size_t in_words { (in_stream.size() + 7) / 8 };
+        auto buffer = std::make_shared<utils::LargeVector<std::uint64_t>>();
+        buffer->reserve(CompressedGraph::header_words + 4 * (nodes + 1) + packed_capacities.size() + out_words + in_words);
+        buffer->assign({ CompressedGraph::magic, CompressedGraph::version, nodes, static_cast<std::uint64_t>(this->capacity_bits),
+                         this->num_arcs, out_stream.size(), in_stream.size(), packed_capacities.size(),
+                         CompressedGraph::flow_supported_flag });
+        for (const auto* array : { &first_out, &out_positions, &first_in, &in_positions, &packed_capacities }) {
+            buffer->insert(buffer->end(), array->begin(), array->end());
+        }
+        std::size_t out_start { buffer->size() };
+        buffer->resize(out_start + out_words + in_words, 0);
+        std::copy(out_stream.begin(), out_stream.end(), reinterpret_cast<std::uint8_t*>(buffer->data() + out_start));
+        std::copy(in_stream.begin(), in_stream.end(), reinterpret_cast<std::uint8_t*>(buffer->data() + out_start + out_words));
+
+        std::size_t words { buffer->size() };
+        this->setImage(std::shared_ptr<const std::uint64_t>(buffer, buffer->data()), words);
+    }
+
+    CompressedGraph::CompressedGraph(const std::string& filename) {
+        int fd { open(filename.c_str(), O_RDONLY) };
+        if (fd < 0) {
+            throw std::invalid_argument("File " + filename + " not found");
+        }
+
+        struct stat file_stat {};
+        if (fstat(fd, &file_stat) != 0 || file_stat.st_size < static_cast<off_t>(CompressedGraph::first_version_header_words * sizeof(std::uint64_t))) {
+            close(fd);
+            throw std::invalid_argument("File " + filename + " is not a compressed graph");
+        }
+
+        // the mapping stays valid after closing the file, it is unmapped with the last copy of the graph
+        std::size_t size { static_cast<std::size_t>(file_stat.st_size) };
+        void* data { mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0) };
+        close(fd);
+        if (data == MAP_FAILED) {
+            throw std::runtime_error("File " + filename + " cannot be mapped");
+        }
+
+        std::shared_ptr<const std::uint64_t> mapping(static_cast<const std::uint64_t*>(data), [size](const std::uint64_t* address) {
+            munmap(const_cast<std::uint64_t*>(address), size);
+        });
+        this->setImage(mapping, size / sizeof(std::uint64_t));
+    }
+
+    void CompressedGraph::save(const std::string& filename) const {
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(this->image.get()), static_cast<std::streamsize>(this->image_words * sizeof(std::uint64_t)));
+        if (!file) {
+            throw std::invalid_argument("File " + filename + " cannot be written");
+        }
+    }
+
+    int CompressedGraph::getNumNodes() const {
+        return this->num_nodes;
+    }
+
+    std::size_t CompressedGraph::getNumArcs() const {
+        return this->num_arcs;
+    }
+
+    int CompressedGraph::getCapacityBits() const {
+        return this->capacity_bits;
+    }
+
+    bool CompressedGraph::isFlowSupported() const {
+        return this->flags & CompressedGraph::flow_supported_flag;
+    }
+
+    std::size_t CompressedGraph::getSizeInBytes() const {
+        return this->image_words * sizeof(std::uint64_t);
+    }
+
+    void CompressedGraph::WriteVarint(std::vector<std::uint8_t>& bytes, std::uint64_t value) {
+        while (value >= 0x80) {
+            bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    void CompressedGraph::setImage(std::shared_ptr<const std::uint64_t> new_image, std::size_t words) {
+        const std::uint64_t* header { new_image.get() };
+        if (words < CompressedGraph::first_version_header_words || header[0] != CompressedGraph::magic ||
+            header[1] < 1 || header[1] > CompressedGraph::version || header[3] > 32) {
+            throw std::invalid_argument("The image is not a compressed graph");
+        }
+
+        // the first version has no flags, its graphs were not checked
+        std::size_t header_size { header[1] == 1 ? CompressedGraph::first_version_header_words : CompressedGraph::header_words };
+        if (words < header_size) {
+            throw std::invalid_argument("The image is not a compressed graph");
+        }
+        std::uint64_t header_flags { header[1] == 1 ? 0 : header[8] };
+        if (header_flags & ~CompressedGraph::flow_supported_flag) {
+            throw std::invalid_argument("The image is not a compressed graph");
+        }
+
+        std::size_t nodes { header[2] };
+        std::size_t out_words { (header[5] + 7) / 8 };
+        std::size_t in_words { (header[6] + 7) / 8 };
+        if (words != header_size + 4 * (nodes + 1) + header[7] + out_words + in_words) {
+            throw std::invalid_argument("The image is not a compressed graph");
+        }
+
+        this->num_nodes = static_cast<int>(nodes);
+        this->capacity_bits = static_cast<int>(header[3]);
+        this->num_arcs = header[4];
+        this->image_words = words;
+        this->flags = header_flags;
+
+        this->first_out_arc = header + header_size;
+        this->out_offset = this->first_out_arc + nodes + 1;
+        this->first_in_arc = this->out_offset + nodes + 1;
+        this->in_offset = this->first_in_arc + nodes + 1;
+        this->capacities = this->in_offset + nodes + 1;
+        this->out_bytes = reinterpret_cast<const std::uint8_t*>(this->capacities + header[7]);
+        this->in_bytes = this->out_bytes + out_words * sizeof(std::uint64_t);
+        this->image = std::move(new_image);
+    }
+}
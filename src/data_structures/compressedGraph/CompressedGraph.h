@@ -0,0 +1,282 @@
+#ifndef NETWORK_FLOWS_COMPRESSEDGRAPH_H
+#define NETWORK_FLOWS_COMPRESSEDGRAPH_H
+
+#include "data_structures/graph/Graph.h"
+#include "data_structures/traversalGraph/TraversalGraph.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace data_structures {
+    /**
+     * Read-only compressed adjacency of a large sparse graph, for the traversals (BFS, Dijkstra) that do not fit
+     * in memory with the general graph (an Edge per arc plus a map node, a vector and a shared pointer per node).
+     * The arcs of each node are sorted by sink and stored in a byte stream: the difference from the previous sink
+     * and the cost (zigzag encoded) as varints, so an arc to a near node with a small cost takes 2 bytes.
+     * The capacities are bit-packed apart, with the number of bits of the maximum capacity.
+     * The arcs entering each node are stored too (source deltas and arc indexes), for the backward residual arcs.
+     * Only the sink, the capacity and the cost of the edges are kept (no ids, cost segments), an undirected edge
+     * is stored as two opposite arcs with its capacity and cost. Lower bounds and node capacities cannot be
+     * represented (see IsSupported()).
+     * The arcs are decoded on the fly while they are visited (see forEachArc()).
+     *
+     * All the arrays are stored in a single image with the same layout in memory and on disk, so a graph
+     * larger than RAM can be saved once (see save()) and memory-mapped (see the file constructor): the operating
+     * system reads the pages of the file when they are visited, and only the state of the algorithm stays in RAM.
+     * The arcs of consecutive nodes are contiguous, so with a locality-friendly numbering of the nodes
+     * (see GraphBaseAlgorithms::NodeOrdering()) a traversal reads the file in long sequential runs.
+     *
+     * (see: https://developers.google.com/protocol-buffers/docs/encoding#varints)
+     */
+    class CompressedGraph {
+        public:
+            /**
+             * Check if a graph can be compressed: without lower bounds and node capacities.
+             *
+             * @param graph the graph to check
+             *
+             * @return true if the graph can be compressed, false otherwise
+             */
+            static bool IsSupported(const std::shared_ptr<Graph>& graph);
+
+            /**
+             * Constructor, compress the edges of the graph in memory.
+             *
+             * V: number of nodes
+             * E: number of edges
+             * Time complexity: O(V + E * log(E))
+             *
+             * @param graph the graph to compress (see IsSupported())
+             *
+             * @throws invalid_argument if the graph cannot be compressed
+             */
+            explicit CompressedGraph(const std::shared_ptr<Graph>& graph);
+
+            /**
+             * Constructor, memory-map a compressed graph saved to a file (see save()).
+             * The file is mapped read-only and it must not change while the graph is used.
+             * The files of the first version of the format were written without checking the graph (see IsSupported()),
+             * they are mapped for the traversals but they cannot be solved (see isFlowSupported()).
+             *
+             * @param filename the file
+             *
+             * @throws invalid_argument if the file does not exist or it is not a compressed graph
+             * @throws runtime_error if the file cannot be mapped
+             */
+            explicit CompressedGraph(const std::string& filename);
+
+            /**
+             * Save the compressed graph to a file, it can be memory-mapped later (see the file constructor).
+             *
+             * @param filename the file
+             *
+             * @throws invalid_argument if the file cannot be written
+             */
+            void save(const std::string& filename) const;
+
+            /**
+             * Get the number of nodes.
+             *
+             * @return the number of nodes
+             */
+            [[nodiscard]] int getNumNodes() const;
+
+            /**
+             * Get the number of arcs.
+             *
+             * @return the number of arcs
+             */
+            [[nodiscard]] std::size_t getNumArcs() const;
+
+            /**
+             * Get the number of bits of each packed capacity.
+             *
+             * @return the number of bits of the maximum capacity
+             */
+            [[nodiscard]] int getCapacityBits() const;
+
+            /**
+             * Check if the arcs are the whole flow network of the graph compressed (the graph was checked with
+             * IsSupported() when it was compressed), so the residual network of the arcs gives its flows
+             * (see CompressedFlowGraph).
+             *
+             * @return true if the compressed graph can be solved, false for the files of the first version of the format
+             */
+            [[nodiscard]] bool isFlowSupported() const;
+
+            /**
+             * Get the size of the image of the compressed graph (in memory or on disk).
+             *
+             * @return the size in bytes
+             */
+            [[nodiscard]] std::size_t getSizeInBytes() const;
+
+            /**
+             * Get the capacity of an arc.
+             *
+             * @param arc the index of the arc (see forEachOutArc())
+             *
+             * @return the capacity
+             */
+            [[nodiscard]] int getCapacity(std::size_t arc) const {
+                if (!this->capacity_bits) {
+                    return 0;
+                }
+
+                // a capacity can span two words, the last word is padding so the next one can always be read
+                std::size_t bit { arc * this->capacity_bits };
+                unsigned shift { static_cast<unsigned>(bit % 64) };
+                std::uint64_t value { this->capacities[bit / 64] >> shift };
+                if (shift + this->capacity_bits > 64) {
+                    value |= this->capacities[bit / 64 + 1] << (64 - shift);
+                }
+                return static_cast<int>(value & ((std::uint64_t{1} << this->capacity_bits) - 1));
+            }
+
+            /**
+             * Visit the arcs leaving a node, in increasing order of sink, decoding them on the fly.
+             *
+             * @param node    the node, it must be a node of the graph
+             * @param visitor the function called with the sink, the capacity and the cost of each arc
+             */
+            template<typename Visitor>
+            void forEachArc(int node, Visitor&& visitor) const {
+                const std::uint8_t* data { this->out_bytes + this->out_offset[node] };
+                int sink {};
+                for (std::size_t arc = this->first_out_arc[node]; arc < this->first_out_arc[node + 1]; arc++) {
+                    sink += static_cast<int>(CompressedGraph::ReadVarint(data));
+                    std::uint32_t cost { static_cast<std::uint32_t>(CompressedGraph::ReadVarint(data)) };
+                    visitor(sink, this->getCapacity(arc), static_cast<int>(cost >> 1) ^ -static_cast<int>(cost & 1));
+                }
+            }
+
+            /**
+             * Visit the arcs leaving a node with their indexes, in increasing order of sink.
+             * The arcs are numbered from 0 to getNumArcs() - 1, in order of source and sink.
+             *
+             * @param node    the node, it must be a node of the graph
+             * @param visitor the function called with the index and the sink of each arc
+             */
+            template<typename Visitor>
+            void forEachOutArc(int node, Visitor&& visitor) const {
+                const std::uint8_t* data { this->out_bytes + this->out_offset[node] };
+                int sink {};
+                for (std::size_t arc = this->first_out_arc[node]; arc < this->first_out_arc[node + 1]; arc++) {
+                    sink += static_cast<int>(CompressedGraph::ReadVarint(data));
+                    CompressedGraph::ReadVarint(data);
+                    visitor(arc, sink);
+                }
+            }
+
+            /**
+             * Visit the arcs entering a node with their indexes, in increasing order of source.
+             *
+             * @param node    the node, it must be a node of the graph
+             * @param visitor the function called with the index and the source of each arc
+             */
+            template<typename Visitor>
+            void forEachInArc(int node, Visitor&& visitor) const {
+                const std::uint8_t* data { this->in_bytes + this->in_offset[node] };
+                int source {};
+                for (std::size_t i = this->first_in_arc[node]; i < this->first_in_arc[node + 1]; i++) {
+                    source += static_cast<int>(CompressedGraph::ReadVarint(data));
+                    visitor(static_cast<std::size_t>(CompressedGraph::ReadVarint(data)), source);
+                }
+            }
+
+        private:
+            // first word of the image ("NFCGRAPH" in ASCII)
+            static constexpr std::uint64_t magic { 0x485041524743464e };
+
+            // version of the format of the image
+            static constexpr std::uint64_t version { 2 };
+
+            // words of the header: magic, version, nodes, capacity bits, arcs, out bytes, in bytes, capacity words, flags
+            // (the first version of the format has no flags)
+            static constexpr std::size_t header_words { 9 };
+            static constexpr std::size_t first_version_header_words { 8 };
+
+            // flag of the images of checked graphs (see isFlowSupported())
+            static constexpr std::uint64_t flow_supported_flag { 1 };
+
+            /**
+             * Append a value to a byte stream as a varint: 7 bits per byte, the high bit is set on all the bytes but the last.
+             *
+             * @param bytes the byte stream
+             * @param value the value
+             */
+            static void WriteVarint(std::vector<std::uint8_t>& bytes, std::uint64_t value);
+
+            /**
+             * Read a varint and move the pointer after it.
+             *
+             * @param data the pointer to the first byte of the varint (moved after its last byte)
+             *
+             * @return the value
+             */
+            static std::uint64_t ReadVarint(const std::uint8_t*& data) {
+                std::uint64_t value {};
+                for (int shift = 0;; shift += 7) {
+                    std::uint8_t byte { *data++ };
+                    value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+                    if (!(byte & 0x80)) {
+                        return value;
+                    }
+                }
+            }
+
+            /**
+             * Use an image (see the layout in CompressedGraph.cpp): check its header and point the arrays inside it.
+             *
+             * @param new_image the image
+             * @param words     the size of the image in 64-bit words
+             *
+             * @throws invalid_argument if the image is not a compressed graph
+             */
+            void setImage(std::shared_ptr<const std::uint64_t> new_image, std::size_t words);
+
+            int num_nodes;
+
+            // number of bits of each packed capacity (0 if all the capacities are 0)
+            int capacity_bits;
+
+            std::size_t num_arcs;
+
+            // size of the image in 64-bit words
+            std::size_t image_words;
+
+            // flags of the header (0 for the first version of the format)
+            std::uint64_t flags;
+
+            // header and arrays (owned vector or file mapping), shared by the copies since it is never modified
+            std::shared_ptr<const std::uint64_t> image;
+
+            // index of the first arc leaving each node, plus the number of arcs at the end
+            const std::uint64_t* first_out_arc;
+
+            // position of the first byte of each node in the stream of the arcs leaving it
+            const std::uint64_t* out_offset;
+
+            // index of the first arc entering each node in the order of the arcs entering the nodes
+            const std::uint64_t* first_in_arc;
+
+            // position of the first byte of each node in the stream of the arcs entering it
+            const std::uint64_t* in_offset;
+
+            // capacities of the arcs, capacity_bits bits each
+            const std::uint64_t* capacities;
+
+            // sink deltas and zigzag costs of the arcs leaving the nodes, as varints
+            const std::uint8_t* out_bytes;
+
+            // source deltas and indexes of the arcs entering the nodes, as varints
+            const std::uint8_t* in_bytes;
+    };
+
+    static_assert(TraversalGraph<CompressedGraph>);
+}
+
+#endif //NETWORK_FLOWS_COMPRESSEDGRAPH_H
@@ -0,0 +1,285 @@
+#include "DenseGraph.h"
+
+#include <bit>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+namespace data_structures {
+    namespace {
+        /**
+         * Relax the residual edges of a row of the matrix leaving the node u (the forward ones if capacity > flow,
+         * the backward ones if the reverse flow > 0). The parent of a node reached with a backward edge is stored
+         * as ~u, so the body is a branch-free select on int arrays that do not alias and the compiler can vectorize it.
+         *
+         * @param n            the number of nodes
+         * @param u            the node of the row
+         * @param base         the distance of u minus its potential
+         * @param capacity_row the capacities of the row (not read for the backward edges)
+         * @param flow_row     the flows of the row (the reverse flows for the backward edges)
+         * @param cost_row     the costs of the row
+         * @param potential    the potential of each node
+         * @param distance     the distance of each node
+         * @param parent       the parent of each node (~parent if it is reached with a backward edge)
+         */
+        template <bool forward_edges>
+        void RelaxRow(int n, int u, int base, const int* __restrict capacity_row, const int* __restrict flow_row,
+                      const int* __restrict cost_row, const int* __restrict potential, int* __restrict distance,
+                      int* __restrict parent) {
+            const int step { forward_edges ? u : ~u };
+            for (int v = 0; v < n; v++) {
+                int candidate { base + cost_row[v] + potential[v] };
+                int d { distance[v] };
+                bool residual { forward_edges ? capacity_row[v] > flow_row[v] : flow_row[v] > 0 };
+                bool relax { residual && candidate < d };
+                distance[v] = relax ? candidate : d;
+                parent[v] = relax ? step : parent[v];
+            }
+        }
+    }
+
+    bool DenseGraph::IsSupported(const std::shared_ptr<Graph>& graph) {
+        long long num_nodes { graph->getNumNodes() };
+        if (!num_nodes || !graph->getNodeCapacities()->empty()) {
+            return false;
+        }
+
+        long long num_edges {};
+        for (int u = 0; u < num_nodes; u++) {
+            num_edges += static_cast<long long>(graph->getNodeAdjList(u)->size());
+        }
+        if (num_edges * DenseGraph::min_density < num_nodes * num_nodes) {
+            return false;
+        }
+
+        std::vector<bool> has_edge(num_nodes, false);
+        for (int u = 0; u < num_nodes; u++) {
+            std::fill(has_edge.begin(), has_edge.end(), false);
+            for (const auto& e : *graph->getNodeAdjList(u)) {
+                if (e.getLowerBound() || e.isUndirected() || e.getCost() < 0 || has_edge.at(e.getSink())) {
+                    return false;
+                }
+                has_edge.at(e.getSink()) = true;
+            }
+        }
+
+        return true;
+    }
+
+    DenseGraph::DenseGraph(const std::shared_ptr<Graph>& graph) :
+        num_nodes(graph->getNumNodes()),
+        num_words((graph->getNumNodes() + 63) / 64) {
+        if (!DenseGraph::IsSupported(graph)) {
+            throw std::invalid_argument("The graph cannot be represented by a dense graph");
+        }
+
+        std::size_t size { static_cast<std::size_t>(this->num_nodes) * this->num_nodes };
+        this->capacity.assign(size, 0);
+        this->cost.assign(size, 0);
+        this->flow.assign(size, 0);
+        this->reverse_cost.assign(size, 0);
+        this->reverse_flow.assign(size, 0);
+        this->forward_bits.assign(static_cast<std::size_t>(this->num_nodes) * this->num_words, 0);
+        this->backward_bits.assign(static_cast<std::size_t>(this->num_nodes) * this->num_words, 0);
+
+        for (int u = 0; u < this->num_nodes; u++) {
+            for (const auto& e : *graph->getNodeAdjList(u)) {
+                int v { e.getSink() };
+                this->capacity.at(static_cast<std::size_t>(u) * this->num_nodes + v) = e.getCapacity();
+                this->cost.at(static_cast<std::size_t>(u) * this->num_nodes + v) = e.getCost();
+                this->reverse_cost.at(static_cast<std::size_t>(v) * this->num_nodes + u) = -e.getCost();
+                this->setFlow(u, v, 0);
+            }
+        }
+    }
+
+    int DenseGraph::maxFlow(int source, int sink) {
+        this->checkNode(source);
+        this->checkNode(sink);
+        if (source == sink) {
+            return 0;
+        }
+
+        int max_flow {};
+        std::vector<int> parent(this->num_nodes, -1);
+        std::vector<std::uint8_t> forward(this->num_nodes, 1);
+        while (this->findShortestPath(source, sink, parent)) {
+            // the BFS does not tell which residual edge reached a node, prefer the forward one
+            for (int v = sink; v != source; v = parent.at(v)) {
+                std::size_t uv { static_cast<std::size_t>(parent.at(v)) * this->num_nodes + v };
+                forward.at(v) = this->capacity[uv] > this->flow[uv];
+            }
+            max_flow += this->augmentPath(source, sink, parent, forward);
+        }
+
+        return max_flow;
+    }
+
+    int DenseGraph::minCostMaxFlow(int source, int sink, std::vector<int>& potential) {
+        this->checkNode(source);
+        this->checkNode(sink);
+
+        const int INF { std::numeric_limits<int>::max() };
+        int n { this->num_nodes };
+
+        // the costs are non-negative, the zero potentials are feasible
+        potential.assign(n, 0);
+
+        int total_flow {};
+        std::vector<int> distance(n);
+        std::vector<int> parent(n);
+        std::vector<std::uint8_t> forward(n);
+        std::vector<std::uint8_t> done(n);
+        while (source != sink) {
+            std::fill(distance.begin(), distance.end(), INF);
+            std::fill(done.begin(), done.end(), 0);
+            distance.at(source) = 0;
+
+            for (int i = 0; i < n; i++) {
+                // the nearest node not done yet (linear scan instead of a heap)
+                int u { -1 };
+                for (int v = 0; v < n; v++) {
+                    if (!done[v] && distance[v] != INF && (u == -1 || distance[v] < distance[u])) {
+                        u = v;
+                    }
+                }
+                if (u == -1) {
+                    break;
+                }
+                done[u] = 1;
+
+                // sweep the rows of u: forward residual edges, then backward residual edges
+                std::size_t row { static_cast<std::size_t>(u) * n };
+                int base { distance[u] - potential[u] };
+                RelaxRow<true>(n, u, base, &this->capacity[row], &this->flow[row], &this->cost[row],
+                               potential.data(), distance.data(), parent.data());
+                RelaxRow<false>(n, u, base, nullptr, &this->reverse_flow[row], &this->reverse_cost[row],
+                                potential.data(), distance.data(), parent.data());
+            }
+
+            if (distance.at(sink) == INF) {
+                break;
+            }
+
+            // update the potentials, the nodes farther than the sink (or not reachable) are treated
+            // as if they were at the same distance of the sink
+            for (int u = 0; u < n; u++) {
+                potential[u] -= std::min(distance[u], distance[sink]);
+            }
+
+            // decode the steps of the path, a negative parent is reached with a backward edge
+            for (int v = sink; v != source; v = parent[v]) {
+                forward[v] = parent[v] >= 0;
+                parent[v] = forward[v] ? parent[v] : ~parent[v];
+            }
+
+            total_flow += this->augmentPath(source, sink, parent, forward);
+        }
+
+        return total_flow;
+    }
+
+    int DenseGraph::getFlow(int source, int sink) const {
+        return this->flow.at(static_cast<std::size_t>(source) * this->num_nodes + sink);
+    }
+
+    int DenseGraph::getNumNodes() const {
+        return this->num_nodes;
+    }
+
+    int DenseGraph::getResidualCapacity(int source, int sink) const {
+        return this->capacity.at(static_cast<std::size_t>(source) * this->num_nodes + sink) - this->getFlow(source, sink)
+            + this->getFlow(sink, source);
+    }
+
+    void DenseGraph::push(int source, int sink, int flow) {
+        int cancelled { std::min(flow, this->getFlow(sink, source)) };
+        if (cancelled) {
+            this->setFlow(sink, source, this->getFlow(sink, source) - cancelled);
+        }
+        if (flow > cancelled) {
+            this->setFlow(source, sink, this->getFlow(source, sink) + flow - cancelled);
+        }
+    }
+
+    bool DenseGraph::findShortestPath(int source, int sink, std::vector<int>& parent) const {
+        std::vector<std::uint64_t> visited(this->num_words, 0);
+        std::vector<std::uint64_t> frontier(this->num_words, 0);
+        std::vector<std::uint64_t> next(this->num_words, 0);
+        visited[source / 64] |= std::uint64_t{1} << (source % 64);
+        frontier[source / 64] |= std::uint64_t{1} << (source % 64);
+
+        // visit one level of the BFS at a time, the nodes reached from a node are the bits of its rows not visited yet
+        bool found { false };
+        bool empty { false };
+        while (!found && !empty) {
+            std::fill(next.begin(), next.end(), 0);
+            for (int w = 0; w < this->num_words; w++) {
+                for (std::uint64_t nodes = frontier[w]; nodes; nodes &= nodes - 1) {
+                    int u { w * 64 + std::countr_zero(nodes) };
+                    const std::uint64_t* forward_row { &this->forward_bits[static_cast<std::size_t>(u) * this->num_words] };
+                    const std::uint64_t* backward_row { &this->backward_bits[static_cast<std::size_t>(u) * this->num_words] };
+
+                    for (int x = 0; x < this->num_words; x++) {
+                        std::uint64_t reached { (forward_row[x] | backward_row[x]) & ~visited[x] };
+                        visited[x] |= reached;
+                        next[x] |= reached;
+
+                        for (; reached; reached &= reached - 1) {
+                            parent[x * 64 + std::countr_zero(reached)] = u;
+                        }
+                    }
+                }
+            }
+
+            std::swap(frontier, next);
+            found = visited[sink / 64] & (std::uint64_t{1} << (sink % 64));
+            empty = std::none_of(frontier.begin(), frontier.end(), [](std::uint64_t word) { return word; });
+        }
+
+        return found;
+    }
+
+    int DenseGraph::augmentPath(int source, int sink, const std::vector<int>& parent, const std::vector<std::uint8_t>& forward) {
+        // bottleneck of the path
+        int path_flow { std::numeric_limits<int>::max() };
+        for (int v = sink; v != source; v = parent.at(v)) {
+            int u { parent.at(v) };
+            path_flow = std::min(path_flow, forward.at(v)
+                ? this->capacity[static_cast<std::size_t>(u) * this->num_nodes + v] - this->getFlow(u, v)
+                : this->getFlow(v, u));
+        }
+
+        // a forward step increases the flow of u -> v, a backward step cancels the flow of v -> u
+        for (int v = sink; v != source; v = parent.at(v)) {
+            int u { parent.at(v) };
+            if (forward.at(v)) {
+                this->setFlow(u, v, this->getFlow(u, v) + path_flow);
+            } else {
+                this->setFlow(v, u, this->getFlow(v, u) - path_flow);
+            }
+        }
+
+        return path_flow;
+    }
+
+    void DenseGraph::setFlow(int source, int sink, int flow) {
+        std::size_t uv { static_cast<std::size_t>(source) * this->num_nodes + sink };
+        std::size_t vu { static_cast<std::size_t>(sink) * this->num_nodes + source };
+        this->flow[uv] = flow;
+        this->reverse_flow[vu] = flow;
+
+        std::uint64_t sink_bit { std::uint64_t{1} << (sink % 64) };
+        std::uint64_t source_bit { std::uint64_t{1} << (source % 64) };
+        std::uint64_t& forward_word { this->forward_bits[static_cast<std::size_t>(source) * this->num_words + sink / 64] };
+        std::uint64_t& backward_word { this->backward_bits[static_cast<std::size_t>(sink) * this->num_words + source / 64] };
+        forward_word = this->capacity[uv] > flow ? forward_word | sink_bit : forward_word & ~sink_bit;
+        backward_word = flow > 0 ? backward_word | source_bit : backward_word & ~source_bit;
+    }
+
+    void DenseGraph::checkNode(int node) const {
+        if (node < 0 || node >= this->num_nodes) {
+            throw std::invalid_argument("The node is not a node of the graph");
+        }
+    }
+}
@@ -0,0 +1,214 @@
+#ifndef NETWORK_FLOWS_DENSEGRAPH_H
+#define NETWORK_FLOWS_DENSEGRAPH_H
+
+#include "data_structures/graph/Graph.h"
+#include "data_structures/flowGraph/FlowGraph.h"
+
+#include <bit>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+namespace data_structures {
+    /**
+     * Matrix representation of a dense graph (number of edges close to V^2) with its flow.
+     * The capacity, the cost and the flow of the edge u -> v are stored at row u, column v of row-major matrices,
+     * so looking up an edge is O(1) and the edges leaving a node are contiguous in memory.
+     * The residual graph is implicit: the edge u -> v has residual capacity capacity - flow forward and flow backward
+     * (anti-parallel edges need no artificial nodes). The backward edges leaving u are the column u of the flow matrix,
+     * so the flow and the cost are also stored transposed, and every residual edge leaving u is read sweeping rows.
+     * Each row has a bitset of its forward and of its backward residual edges, so a BFS visits 64 nodes per word operation.
+     * It is a FlowGraph, so the generic algorithms can also run on it (see FlowGraphAlgorithms.h).
+     */
+    class DenseGraph {
+        public:
+            // a graph is dense if E * min_density >= V^2
+            static constexpr int min_density { 4 };
+
+            /**
+             * Check if a graph can be represented by a dense graph: dense, without parallel edges, lower bounds,
+             * undirected edges, node capacities and negative costs.
+             *
+             * @param graph the graph to check
+             *
+             * @return true if the graph can be represented, false otherwise
+             */
+            static bool IsSupported(const std::shared_ptr<Graph>& graph);
+
+            /**
+             * Constructor, the flow starts at zero.
+             *
+             * @param graph the graph (see IsSupported())
+             *
+             * @throws invalid_argument if the graph cannot be represented by a dense graph
+             */
+            explicit DenseGraph(const std::shared_ptr<Graph>& graph);
+
+            /**
+             * Edmonds-Karp algorithm on the matrices: the shortest augmenting paths are found with a BFS on the row bitsets.
+             * The flow is augmented from the current one.
+             *
+             * V: number of nodes
+             * E: number of edges
+             * Time complexity: O(V * E * V^2 / 64)
+             *
+             * @param source the source node
+             * @param sink   the sink node
+             *
+             * @return the flow sent from source to sink
+             *
+             * @throws invalid_argument if the source or the sink is not a node of the graph
+             */
+            int maxFlow(int source, int sink);
+
+            /**
+             * Successive Shortest Path algorithm on the matrices, starting from the zero flow.
+             * The shortest paths are found with the array version of Dijkstra (no heap), which is optimal on dense graphs:
+             * each step sweeps the rows of the nearest node. The reduced costs are kept non-negative by the node potentials.
+             * The result is the minimum cost maximum flow from source to sink.
+             *
+             * (see: https://www.topcoder.com/thrive/articles/Minimum%20Cost%20Flow%20Part%20Two:%20Algorithms)
+             *
+             * V: number of nodes
+             * F: maximum flow
+             * Time complexity: O(F * V^2)
+             *
+             * @param source    the source node
+             * @param sink      the sink node
+             * @param potential the potential of each node (output), the reduced cost of the edge u -> v
+             *                  is cost - potential[u] + potential[v]
+             *
+             * @return the flow sent from source to sink
+             *
+             * @throws invalid_argument if the source or the sink is not a node of the graph
+             */
+            int minCostMaxFlow(int source, int sink, std::vector<int>& potential);
+
+            /**
+             * Get the flow of an edge.
+             *
+             * @param source the source node
+             * @param sink   the sink node
+             *
+             * @return the flow of the edge source -> sink (0 if there is no edge)
+             */
+            [[nodiscard]] int getFlow(int source, int sink) const;
+
+            /**
+             * Get the number of nodes.
+             *
+             * @return the number of nodes
+             */
+            [[nodiscard]] int getNumNodes() const;
+
+            /**
+             * Visit each node reachable from the node with a forward or a backward residual edge, in increasing order.
+             *
+             * @param node    the node
+             * @param visitor the function called with each node
+             */
+            template<typename Visitor>
+            void forEachResidualNeighbor(int node, Visitor&& visitor) const {
+                std::size_t row { static_cast<std::size_t>(node) * this->num_words };
+                for (int w = 0; w < this->num_words; w++) {
+                    for (std::uint64_t nodes = this->forward_bits[row + w] | this->backward_bits[row + w]; nodes; nodes &= nodes - 1) {
+                        visitor(w * 64 + std::countr_zero(nodes));
+                    }
+                }
+            }
+
+            /**
+             * Get the residual capacity from source to sink: the capacity left on the edge source -> sink
+             * plus the flow of the edge sink -> source.
+             *
+             * @param source the source node
+             * @param sink   the sink node
+             *
+             * @return the residual capacity
+             */
+            [[nodiscard]] int getResidualCapacity(int source, int sink) const;
+
+            /**
+             * Send flow from source to sink: the flow of the edge sink -> source is cancelled first,
+             * the rest goes on the edge source -> sink.
+             *
+             * @param source the source node
+             * @param sink   the sink node
+             * @param flow   the flow to send (at most the residual capacity)
+             */
+            void push(int source, int sink, int flow);
+
+        private:
+            /**
+             * Find the shortest path source -> sink in the residual graph (BFS on the row bitsets).
+             *
+             * @param source the source node
+             * @param sink   the sink node
+             * @param parent the parent of each node in the BFS tree (output)
+             *
+             * @return true if the sink is reachable, false otherwise
+             */
+            bool findShortestPath(int source, int sink, std::vector<int>& parent) const;
+
+            /**
+             * Send flow along the path to the sink of the parent tree, each step uses the forward residual edge
+             * if forward is true for its last node, the backward one otherwise.
+             *
+             * @param source  the source node
+             * @param sink    the sink node
+             * @param parent  the parent of each node
+             * @param forward 1 if the step to each node uses the forward residual edge, 0 otherwise
+             *
+             * @return the flow sent (the minimum residual capacity of the path)
+             */
+            int augmentPath(int source, int sink, const std::vector<int>& parent, const std::vector<std::uint8_t>& forward);
+
+            /**
+             * Set the flow of the edge source -> sink, keeping the transposed flow and the row bitsets aligned.
+             *
+             * @param source the source node
+             * @param sink   the sink node
+             * @param flow   the new flow
+             */
+            void setFlow(int source, int sink, int flow);
+
+            /**
+             * Check that a node is a node of the graph.
+             *
+             * @param node the node to check
+             *
+             * @throws invalid_argument if the node is not a node of the graph
+             */
+            void checkNode(int node) const;
+
+            int num_nodes;
+
+            // number of 64-bit words of each row bitset
+            int num_words;
+
+            // capacity of each edge (0 if there is no edge)
+            std::vector<int> capacity;
+
+            // cost of each edge
+            std::vector<int> cost;
+
+            // flow of each edge
+            std::vector<int> flow;
+
+            // reverse_cost[u][v] = -cost[v][u], cost of the backward residual edge u -> v
+            std::vector<int> reverse_cost;
+
+            // reverse_flow[u][v] = flow[v][u], capacity of the backward residual edge u -> v
+            std::vector<int> reverse_flow;
+
+            // bit v of the row u is set if the forward residual edge u -> v has capacity
+            std::vector<std::uint64_t> forward_bits;
+
+            // bit v of the row u is set if the backward residual edge u -> v has capacity
+            std::vector<std::uint64_t> backward_bits;
+    };
+
+    static_assert(FlowGraph<DenseGraph>);
+}
+
+#endif //NETWORK_FLOWS_DENSEGRAPH_H
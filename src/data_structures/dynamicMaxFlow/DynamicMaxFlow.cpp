@@ -0,0 +1,295 @@
+#include "DynamicMaxFlow.h"
+
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+namespace data_structures {
+    DynamicMaxFlow::DynamicMaxFlow(const std::shared_ptr<Graph>& graph, int source, int sink) :
+        source(source),
+        sink(sink),
+        flow_value(0),
+        dirty(true),
+        current_mark(0) {
+        if (!graph->getNodeCapacities()->empty()) {
+            throw std::invalid_argument("Dynamic maximum flow does not support node capacities");
+        }
+
+        // the flow is stored by source and sink, so the graphs cannot have parallel edges
+        this->graph = std::make_shared<Graph>(graph->getNumNodes(), false, graph->getMemoryResource());
+        this->reverse_graph = std::make_shared<Graph>(graph->getNumNodes(), false, graph->getMemoryResource());
+
+        for (int u = 0; u < graph->getNumNodes(); u++) {
+            for (auto e : *graph->getNodeAdjList(u)) {
+                if (e.getLowerBound()) {
+                    throw std::invalid_argument("Dynamic maximum flow does not support lower bounds");
+                }
+                if (e.isUndirected()) {
+                    throw std::invalid_argument("Dynamic maximum flow does not support undirected edges");
+                }
+                if (this->graph->hasEdge(u, e.getSink())) {
+                    throw std::invalid_argument("Dynamic maximum flow does not support parallel edges");
+                }
+                this->graph->addEdge(e);
+
+                // the reversed edge keeps the id, to find the flow of the edge
+                Edge reverse_edge(e.getSink(), u, e.getCapacity(), e.getCost());
+                reverse_edge.setId(e.getId());
+                this->reverse_graph->addEdge(reverse_edge);
+            }
+        }
+
+        this->flow.assign(this->graph->getNumEdgeIds(), 0);
+    }
+
+    void DynamicMaxFlow::addEdge(int source, int sink, int capacity, int cost) {
+        this->graph->addEdge(source, sink, capacity, cost);
+        auto edge = this->graph->getEdgeUnchecked(source, sink);
+        Edge reverse_edge(sink, source, capacity, cost);
+        reverse_edge.setId(edge.getId());
+        this->reverse_graph->addEdge(reverse_edge);
+        this->flow.resize(this->graph->getNumEdgeIds(), 0);
+        if (this->inTransaction()) {
+            this->undo_log.push_back({ ChangeType::Insertion, edge, 0 });
+        }
+
+        // the current flow is still feasible, new paths could be available
+        this->dirty = true;
+    }
+
+    void DynamicMaxFlow::removeEdge(int source, int sink) {
+        // the edge cannot be used to reroute its own flow
+        this->setEdgeCapacity(source, sink, 0);
+        if (this->inTransaction()) {
+            this->undo_log.push_back({ ChangeType::Removal, this->graph->getEdge(source, sink), 0 });
+        }
+        this->graph->removeEdge(source, sink);
+        this->reverse_graph->removeEdge(sink, source);
+    }
+
+    void DynamicMaxFlow::setEdgeCapacity(int source, int sink, int capacity) {
+        if (this->inTransaction()) {
+            this->undo_log.push_back({ ChangeType::Capacity, this->graph->getEdge(source, sink), 0 });
+        }
+        this->graph->setEdgeCapacity(source, sink, capacity);
+        this->reverse_graph->setEdgeCapacity(sink, source, capacity);
+
+        this->cancelExceedingFlow(source, sink, capacity);
+        this->dirty = true;
+    }
+
+    int DynamicMaxFlow::getMaxFlow() {
+        // augment starting from the current flow
+        if (this->dirty) {
+            this->flow_value += this->sendResidualFlow(this->source, this->sink, std::numeric_limits<int>::max());
+            this->dirty = false;
+        }
+
+        return this->flow_value;
+    }
+
+    void DynamicMaxFlow::beginTransaction() {
+        this->savepoints.push_back({ this->undo_log.size(), this->flow_value, this->dirty });
+    }
+
+    void DynamicMaxFlow::commitTransaction() {
+        if (!this->inTransaction()) {
+            throw std::logic_error("There is no open transaction");
+        }
+        this->savepoints.pop_back();
+
+        // the changes are needed only by the rollback of an outer transaction
+        if (!this->inTransaction()) {
+            this->undo_log.clear();
+        }
+    }
+
+    void DynamicMaxFlow::rollbackTransaction() {
+        if (!this->inTransaction()) {
+            throw std::logic_error("There is no open transaction");
+        }
+        auto savepoint = this->savepoints.back();
+        this->savepoints.pop_back();
+
+        // undo the changes in reverse order
+        while (this->undo_log.size() > savepoint.log_size) {
+            auto change = this->undo_log.back();
+            this->undo_log.pop_back();
+
+            int u { change.edge.getSource() };
+            int v { change.edge.getSink() };
+            switch (change.type) {
+                case ChangeType::Flow:
+                    this->flow.at(change.edge.getId()) = change.flow;
+                    break;
+                case ChangeType::Capacity:
+                    this->graph->setEdgeCapacityUnchecked(u, v, change.edge.getCapacity());
+                    this->reverse_graph->setEdgeCapacityUnchecked(v, u, change.edge.getCapacity());
+                    break;
+                case ChangeType::Insertion:
+                    this->graph->removeEdgeUnchecked(u, v);
+                    this->reverse_graph->removeEdgeUnchecked(v, u);
+                    break;
+                case ChangeType::Removal: {
+                    this->graph->addEdge(change.edge);
+                    Edge reverse_edge(v, u, change.edge.getCapacity(), change.edge.getCost());
+                    reverse_edge.setId(change.edge.getId());
+                    this->reverse_graph->addEdge(reverse_edge);
+                    break;
+                }
+            }
+        }
+
+        this->flow_value = savepoint.flow_value;
+        this->dirty = savepoint.dirty;
+    }
+
+    bool DynamicMaxFlow::inTransaction() const {
+        return !this->savepoints.empty();
+    }
+
+    int DynamicMaxFlow::getEdgeFlow(int source, int sink) const {
+        if (!this->graph->hasEdge(source, sink)) {
+            return 0;
+        }
+        return this->flow.at(this->graph->getEdgeUnchecked(source, sink).getId());
+    }
+
+    std::shared_ptr<Graph> DynamicMaxFlow::getFlowGraph() const {
+        auto flow_graph = std::make_shared<Graph>(this->graph->getNumNodes(), false, this->graph->getMemoryResource());
+
+        // the edges keep their ids (see GraphUtils::GetEdgeFlow())
+        for (int u = 0; u < this->graph->getNumNodes(); u++) {
+            for (auto e : *this->graph->getNodeAdjList(u)) {
+                e.setCapacity(this->flow.at(e.getId()));
+                flow_graph->addEdge(e);
+            }
+        }
+
+        return flow_graph;
+    }
+
+    void DynamicMaxFlow::setFlow(int edge, int flow) {
+        if (this->inTransaction()) {
+            Edge change_edge(0, 0, 0, 0);
+            change_edge.setId(edge);
+            this->undo_log.push_back({ ChangeType::Flow, change_edge, this->flow.at(edge) });
+        }
+
+        this->flow.at(edge) = flow;
+    }
+
+    bool DynamicMaxFlow::findResidualPath(int from, int to) {
+        int num_nodes { this->graph->getNumNodes() };
+        if (static_cast<int>(this->visit_mark.size()) < num_nodes) {
+            this->visit_mark.resize(num_nodes, 0);
+            this->parent.resize(num_nodes, -1);
+            this->parent_edge.resize(num_nodes, 0);
+            this->parent_residual.resize(num_nodes, 0);
+        }
+
+        // a new mark forgets the previous visits, the marks are cleared only when they run out
+        if (this->current_mark == std::numeric_limits<int>::max()) {
+            std::fill(this->visit_mark.begin(), this->visit_mark.end(), 0);
+            this->current_mark = 0;
+        }
+        int mark { ++this->current_mark };
+
+        this->visit_mark.at(from) = mark;
+        this->queue.clear();
+        this->queue.push_back(from);
+
+        for (std::size_t head = 0; head < this->queue.size() && this->visit_mark.at(to) != mark; head++) {
+            int node { this->queue.at(head) };
+
+            // edges forward with residual capacity
+            for (const auto& e : *this->graph->getNodeAdjList(node)) {
+                int next { e.getSink() };
+                int residual_capacity { e.getCapacity() - this->flow.at(e.getId()) };
+                if (this->visit_mark.at(next) != mark && residual_capacity > 0) {
+                    this->visit_mark.at(next) = mark;
+                    this->parent.at(next) = node;
+                    this->parent_edge.at(next) = e.getId();
+                    this->parent_residual.at(next) = residual_capacity;
+                    this->queue.push_back(next);
+                }
+            }
+
+            // edges backward with flow to cancel
+            for (const auto& e : *this->reverse_graph->getNodeAdjList(node)) {
+                int next { e.getSink() };
+                int residual_capacity { this->flow.at(e.getId()) };
+                if (this->visit_mark.at(next) != mark && residual_capacity > 0) {
+                    this->visit_mark.at(next) = mark;
+                    this->parent.at(next) = node;
+                    this->parent_edge.at(next) = ~e.getId();
+                    this->parent_residual.at(next) = residual_capacity;
+                    this->queue.push_back(next);
+                }
+            }
+        }
+
+        return from != to && this->visit_mark.at(to) == mark;
+    }
+
+    int DynamicMaxFlow::sendResidualFlow(int from, int to, int max_flow) {
+        int sent {};
+
+        while (sent < max_flow && this->findResidualPath(from, to)) {
+            // find the minimum residual capacity of the path
+            int path_flow { max_flow - sent };
+            for (int node = to; node != from; node = this->parent.at(node)) {
+                path_flow = std::min(path_flow, this->parent_residual.at(node));
+            }
+
+            // send the flow: add it on the edges forward, cancel it on the edges backward
+            for (int node = to; node != from; node = this->parent.at(node)) {
+                int edge { this->parent_edge.at(node) };
+                if (edge >= 0) {
+                    this->setFlow(edge, this->flow.at(edge) + path_flow);
+                } else {
+                    this->setFlow(~edge, this->flow.at(~edge) - path_flow);
+                }
+            }
+
+            sent += path_flow;
+        }
+
+        return sent;
+    }
+
+    void DynamicMaxFlow::cancelExceedingFlow(int source, int sink, int capacity) {
+        int edge { this->graph->getEdgeUnchecked(source, sink).getId() };
+        int edge_flow { this->flow.at(edge) };
+        if (edge_flow <= capacity) {
+            return;
+        }
+
+        // remove the exceeding flow from the edge: source has now an excess and sink a deficit
+        int excess { edge_flow - capacity };
+        this->setFlow(edge, capacity);
+
+        // first try to reroute the excess on other paths, the flow value does not change
+        excess -= this->sendResidualFlow(source, sink, excess);
+        if (!excess) {
+            return;
+        }
+
+        // the excess of source goes back to a terminal (the flow value is the net flow leaving this->source)
+        if (source == this->source) {
+            this->flow_value -= excess;
+        } else if (source != this->sink) {
+            int sent_back { this->sendResidualFlow(source, this->source, excess) };
+            this->flow_value -= sent_back;
+            this->sendResidualFlow(source, this->sink, excess - sent_back);
+        }
+
+        // the deficit of sink is taken back from a terminal
+        if (sink == this->source) {
+            this->flow_value += excess;
+        } else if (sink != this->sink) {
+            int taken_back { this->sendResidualFlow(this->sink, sink, excess) };
+            this->flow_value += this->sendResidualFlow(this->source, sink, excess - taken_back);
+        }
+    }
+}
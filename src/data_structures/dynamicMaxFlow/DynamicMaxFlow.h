@@ -0,0 +1,244 @@
+#ifndef NETWORK_FLOWS_DYNAMICMAXFLOW_H
+#define NETWORK_FLOWS_DYNAMICMAXFLOW_H
+
+#include "data_structures/graph/Graph.h"
+
+#include <memory>
+#include <vector>
+#include <utility>
+
+namespace data_structures {
+    /**
+     * Class maintaining a maximum flow while the edges of the graph are inserted, removed or change capacity.
+     * The flow of each edge is stored apart from the graph in a flat array indexed by edge id, so the residual graph
+     * is implicit: the edge u -> v has residual capacity capacity - flow forward and flow backward (anti-parallel edges
+     * need no artificial nodes). The reversed copy of each edge keeps its id, so both directions find the flow in O(1).
+     * Every update keeps the flow feasible repairing it locally:
+     *  - an insertion or a capacity increase leaves the flow feasible;
+     *  - a removal or a capacity decrease cancels the flow exceeding the new capacity: the excess is rerouted
+     *    from the tail to the head of the edge if possible, else it is sent back to the source (and the
+     *    corresponding deficit is taken back from the sink). The searches start from the endpoints of the changed edge
+     *    and stop as soon as they reach their target, reusing the same buffers, so a local repair visits only
+     *    the nodes around the edge instead of allocating and clearing arrays of the size of the graph.
+     * The flow is augmented again only when the maximum flow is requested, so a batch of updates pays
+     * a single augmentation phase, which starts from the current flow instead of from zero.
+     * What-if analysis does not need copies of the graph: inside a transaction every change of an edge or of its flow
+     * is recorded in an undo log, and a rollback undoes the changes in reverse order, in time proportional to their number.
+     * The transactions can be nested.
+     */
+    class DynamicMaxFlow {
+        public:
+            /**
+             * Constructor, the flow starts at zero and it is computed at the first getMaxFlow().
+             *
+             * @param graph  the starting graph (it is copied)
+             * @param source the source node
+             * @param sink   the sink node
+             *
+             * @throws invalid_argument if the graph has lower bounds
+             * @throws invalid_argument if the graph has parallel edges (the edges are addressed by source and sink)
+             * @throws invalid_argument if the graph has undirected edges or node capacities
+             */
+            DynamicMaxFlow(const std::shared_ptr<Graph>& graph, int source, int sink);
+
+            /**
+             * Insert the edge source -> sink.
+             *
+             * @param source   the source node
+             * @param sink     the sink node
+             * @param capacity the capacity of the edge
+             * @param cost     the cost of the edge
+             *
+             * @throws invalid_argument if the edge already exists or it is not valid (see Graph::addEdge())
+             */
+            void addEdge(int source, int sink, int capacity, int cost);
+
+            /**
+             * Remove the edge source -> sink, cancelling its flow.
+             *
+             * @param source the source node
+             * @param sink   the sink node
+             *
+             * @throws invalid_argument if the edge does not exist
+             */
+            void removeEdge(int source, int sink);
+
+            /**
+             * Set the capacity of the edge source -> sink, cancelling the flow exceeding the new capacity.
+             *
+             * @param source   the source node
+             * @param sink     the sink node
+             * @param capacity the new capacity
+             *
+             * @throws invalid_argument if the edge does not exist
+             * @throws invalid_argument if the capacity is negative
+             */
+            void setEdgeCapacity(int source, int sink, int capacity);
+
+            /**
+             * Get the maximum flow after the updates applied so far.
+             * The flow is augmented from the current one if some update happened since the last call.
+             *
+             * V: number of nodes
+             * E: number of edges
+             * Time complexity: O(V * E^2) in the worst case, usually a few augmenting paths per batch
+             *
+             * @return the maximum flow
+             */
+            int getMaxFlow();
+
+            /**
+             * Begin a transaction (a what-if): the following updates and augmentations can be undone with rollback().
+             * A transaction can be started inside another one.
+             */
+            void beginTransaction();
+
+            /**
+             * Keep the changes of the innermost transaction and close it
+             * (they are still undone by the rollback of an outer transaction).
+             *
+             * @throws logic_error if there is no open transaction
+             */
+            void commitTransaction();
+
+            /**
+             * Undo the changes of the innermost transaction (edges, capacities and flow) and close it.
+             *
+             * E: number of changes in the transaction
+             * Time complexity: O(E * V)
+             *
+             * @throws logic_error if there is no open transaction
+             */
+            void rollbackTransaction();
+
+            /**
+             * Check if a transaction is open.
+             *
+             * @return true if there is an open transaction, false otherwise
+             */
+            [[nodiscard]] bool inTransaction() const;
+
+            /**
+             * Get the flow of an edge.
+             *
+             * @param source the source node
+             * @param sink   the sink node
+             *
+             * @return the flow of the edge source -> sink (0 if there is no flow)
+             */
+            [[nodiscard]] int getEdgeFlow(int source, int sink) const;
+
+            /**
+             * Get the graph with the current flow as capacity of each edge (same format of GraphUtils::GetOptimalGraph()).
+             *
+             * @return the graph with the flow
+             */
+            [[nodiscard]] std::shared_ptr<Graph> getFlowGraph() const;
+
+        private:
+            // kind of a change recorded in the undo log
+            enum class ChangeType { Flow, Capacity, Insertion, Removal };
+
+            /**
+             * Change recorded in the undo log, with what is needed to undo it:
+             * - Flow: the edge and its previous flow
+             * - Capacity: the edge with its previous capacity
+             * - Insertion: the inserted edge
+             * - Removal: the removed edge
+             */
+            struct Change {
+                ChangeType type;
+                Edge edge;
+                int flow;
+            };
+
+            // start of a transaction: position in the undo log and state of the flow
+            struct Savepoint {
+                std::size_t log_size;
+                int flow_value;
+                bool dirty;
+            };
+
+            /**
+             * Set the flow of an edge, recording the previous one if a transaction is open.
+             *
+             * @param edge the id of the edge
+             * @param flow the new flow
+             */
+            void setFlow(int edge, int flow);
+
+            /**
+             * Find the shortest path from -> to in the implicit residual graph (BFS), stopping when to is reached.
+             * The path is left in the BFS tree (see parent, parent_edge and parent_residual), from to back to from.
+             * The buffers are reused: a node is visited if its mark is the current one, so they are not cleared.
+             *
+             * N: number of nodes visited
+             * Time complexity: O(edges of the N nodes)
+             *
+             * @param from the first node
+             * @param to   the last node
+             *
+             * @return true if there is a path, false otherwise
+             */
+            bool findResidualPath(int from, int to);
+
+            /**
+             * Send up to max_flow units in the residual graph along shortest paths from -> to.
+             *
+             * @param from     the first node
+             * @param to       the last node
+             * @param max_flow the maximum amount to send
+             *
+             * @return the amount sent
+             */
+            int sendResidualFlow(int from, int to, int max_flow);
+
+            /**
+             * Reduce the flow of the edge source -> sink to the given capacity and repair the flow conservation.
+             *
+             * @param source   the source node
+             * @param sink     the sink node
+             * @param capacity the capacity to respect
+             */
+            void cancelExceedingFlow(int source, int sink, int capacity);
+
+            // the graph with the capacities
+            std::shared_ptr<Graph> graph;
+
+            // the graph with every edge reversed, used to cancel flow backward
+            std::shared_ptr<Graph> reverse_graph;
+
+            // flow of each edge id (0 for the ids of removed edges)
+            std::vector<int> flow;
+
+            int source;
+            int sink;
+
+            // current value of the flow
+            int flow_value;
+
+            // true if some update happened since the last augmentation
+            bool dirty;
+
+            // changes since the start of the outermost open transaction
+            std::vector<Change> undo_log;
+
+            // open transactions, the innermost is the last
+            std::vector<Savepoint> savepoints;
+
+            // buffers of the BFS, reused by every search: the nodes with visit_mark equal to current_mark were visited
+            std::vector<int> visit_mark;
+            int current_mark;
+
+            // node of the BFS tree before each node, and the edge used: its id if forward, ~id if it cancels flow backward
+            std::vector<int> parent;
+            std::vector<int> parent_edge;
+
+            // residual capacity of the edge used to reach each node
+            std::vector<int> parent_residual;
+
+            std::vector<int> queue;
+    };
+}
+
+#endif //NETWORK_FLOWS_DYNAMICMAXFLOW_H
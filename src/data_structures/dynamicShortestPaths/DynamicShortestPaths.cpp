@@ -0,0 +1,221 @@
+#include "DynamicShortestPaths.h"
+
+#include "consts/Consts.h"
+
+#include <algorithm>
+
+namespace data_structures {
+    DynamicShortestPaths::DynamicShortestPaths(const std::shared_ptr<Graph>& graph, int source, std::vector<int>& potential) :
+        graph(graph),
+        potential(potential),
+        neighbors(graph->getNumNodes()),
+        source(source),
+        distance_offset(0),
+        affected(graph->getNumNodes(), false) {
+
+        for (int u = 0; u < graph->getNumNodes(); u++) {
+            for (auto e : *graph->getNodeAdjList(u)) {
+                this->neighbors.at(u).push_back(e.getSink());
+                this->neighbors.at(e.getSink()).push_back(u);
+            }
+        }
+
+        this->reset(source);
+    }
+
+    int DynamicShortestPaths::getSource() const {
+        return this->source;
+    }
+
+    int DynamicShortestPaths::getDistance(int node) const {
+        if (this->distance.at(node) == unreachable_distance) {
+            return std::numeric_limits<int>::max();
+        }
+        return static_cast<int>(this->distance.at(node) - this->distance_offset);
+    }
+
+    const std::vector<int>& DynamicShortestPaths::getParent() const {
+        return this->parent;
+    }
+
+    std::shared_ptr<std::vector<int>> DynamicShortestPaths::getPath(int target) const {
+        auto path = std::make_shared<std::vector<int>>();
+        for (int u = target; u != consts::source_parent; u = this->parent.at(u)) {
+            path->push_back(u);
+        }
+
+        std::reverse(path->begin(), path->end());
+        return path;
+    }
+
+    void DynamicShortestPaths::reset(int source) {
+        int num_nodes { this->graph->getNumNodes() };
+        this->source = source;
+
+        this->distance.assign(num_nodes, unreachable_distance);
+        this->distance_offset = 0;
+        this->parent.assign(num_nodes, consts::source_parent);
+        this->first_child.assign(num_nodes, -1);
+        this->next_sibling.assign(num_nodes, -1);
+        this->previous_sibling.assign(num_nodes, -1);
+        this->distance.at(source) = 0;
+
+        std::priority_queue<std::pair<long long, int>, std::vector<std::pair<long long, int>>, std::greater<>> queue;
+        queue.emplace(0, source);
+        this->search(queue, {});
+    }
+
+    void DynamicShortestPaths::shiftDistances(int target) {
+        long long max_distance { this->distance.at(target) - this->distance_offset };
+        if (max_distance <= 0) {
+            return;
+        }
+
+        // the distances only grow along the edges of the tree, so the nodes nearer than the target are a subtree
+        // of the source: they get distance 0, the others are moved by the offset
+        this->distance_offset += max_distance;
+
+        std::vector<int> stack { this->source };
+        while (!stack.empty()) {
+            int u { stack.back() };
+            stack.pop_back();
+
+            this->potential.at(u) += static_cast<int>(this->distance_offset - this->distance.at(u));
+            this->distance.at(u) = this->distance_offset;
+
+            for (int v = this->first_child.at(u); v != -1; v = this->next_sibling.at(v)) {
+                if (this->distance.at(v) < this->distance_offset) {
+                    stack.push_back(v);
+                }
+            }
+        }
+    }
+
+    void DynamicShortestPaths::repair(const std::shared_ptr<std::vector<int>>& path) {
+        // the tree edges of the path removed from the graph, the backward edges cannot shorten any path
+        // since they have reduced cost 0 and they enter nodes of the path (distance 0)
+        std::vector<int> roots;
+        for (unsigned i = 0; i + 1 < path->size(); i++) {
+            int u { path->at(i) };
+            int v { path->at(i + 1) };
+            if (this->parent.at(v) == u && !this->graph->hasEdge(u, v)) {
+                roots.push_back(v);
+            }
+        }
+
+        if (roots.empty()) {
+            return;
+        }
+
+        // the nodes of the subtrees below the removed edges lose their distance
+        std::vector<int> affected_nodes;
+        for (int root : roots) {
+            if (this->affected.at(root)) {
+                continue;
+            }
+            std::vector<int> stack { root };
+            this->affected.at(root) = true;
+            while (!stack.empty()) {
+                int u { stack.back() };
+                stack.pop_back();
+                affected_nodes.push_back(u);
+                for (int v = this->first_child.at(u); v != -1; v = this->next_sibling.at(v)) {
+                    if (!this->affected.at(v)) {
+                        this->affected.at(v) = true;
+                        stack.push_back(v);
+                    }
+                }
+            }
+        }
+
+        for (int v : affected_nodes) {
+            this->distance.at(v) = unreachable_distance;
+            this->setParent(v, consts::source_parent);
+        }
+
+        // seed the affected nodes with the edges coming from the nodes with a valid distance
+        std::priority_queue<std::pair<long long, int>, std::vector<std::pair<long long, int>>, std::greater<>> queue;
+        for (int v : affected_nodes) {
+            for (int u : this->neighbors.at(v)) {
+                if (this->affected.at(u) || this->distance.at(u) == unreachable_distance || !this->graph->hasEdge(u, v)) {
+                    continue;
+                }
+                long long d { this->distance.at(u) + this->getReducedCost(u, this->graph->getEdgeUnchecked(u, v)) };
+                if (d < this->distance.at(v)) {
+                    this->distance.at(v) = d;
+                    this->setParent(v, u);
+                }
+            }
+            if (this->distance.at(v) != unreachable_distance) {
+                queue.emplace(this->distance.at(v), v);
+            }
+        }
+
+        // Dijkstra limited to the affected nodes
+        this->search(queue, this->affected);
+
+        for (int v : affected_nodes) {
+            this->affected.at(v) = false;
+        }
+    }
+
+    int DynamicShortestPaths::getReducedCost(int source, const Edge& edge) const {
+        return edge.getCost() - this->potential.at(source) + this->potential.at(edge.getSink());
+    }
+
+    void DynamicShortestPaths::setParent(int node, int parent) {
+        int old_parent { this->parent.at(node) };
+        if (old_parent == parent) {
+            return;
+        }
+
+        // unlink the node from the children of the old parent
+        if (old_parent != consts::source_parent) {
+            int previous { this->previous_sibling.at(node) };
+            int next { this->next_sibling.at(node) };
+            if (previous != -1) {
+                this->next_sibling.at(previous) = next;
+            } else {
+                this->first_child.at(old_parent) = next;
+            }
+            if (next != -1) {
+                this->previous_sibling.at(next) = previous;
+            }
+        }
+
+        // link the node at the head of the children of the new parent
+        this->parent.at(node) = parent;
+        this->previous_sibling.at(node) = -1;
+        this->next_sibling.at(node) = -1;
+        if (parent != consts::source_parent) {
+            int next { this->first_child.at(parent) };
+            this->next_sibling.at(node) = next;
+            if (next != -1) {
+                this->previous_sibling.at(next) = node;
+            }
+            this->first_child.at(parent) = node;
+        }
+    }
+
+    void DynamicShortestPaths::search(std::priority_queue<std::pair<long long, int>, std::vector<std::pair<long long, int>>, std::greater<>>& queue,
+                                      const std::vector<bool>& allowed) {
+        while (!queue.empty()) {
+            auto [d, u] = queue.top();
+            queue.pop();
+
+            if (d > this->distance.at(u)) {
+                continue;
+            }
+
+            for (const auto& e : this->graph->getNodeAdjListUnchecked(u)) {
+                int v { e.getSink() };
+                long long new_distance { d + this->getReducedCost(u, e) };
+                if ((allowed.empty() || allowed.at(v)) && new_distance < this->distance.at(v)) {
+                    this->distance.at(v) = new_distance;
+                    this->setParent(v, u);
+                    queue.emplace(new_distance, v);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,186 @@
+#ifndef NETWORK_FLOWS_DYNAMICSHORTESTPATHS_H
+#define NETWORK_FLOWS_DYNAMICSHORTESTPATHS_H
+
+#include "data_structures/graph/Graph.h"
+
+#include <queue>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <functional>
+
+namespace data_structures {
+    /**
+     * Class maintaining the shortest path tree of a residual graph with non-negative reduced costs
+     * between the augmentations of Successive Shortest Path, instead of running Dijkstra from scratch each time.
+     * The graph keeps its original costs: the potentials of the nodes are kept in a separate array and
+     * the reduced cost of each edge u -> v, cost - potential[u] + potential[v], is evaluated while it is visited.
+     * The graph is not copied: the caller changes it and notifies the changes.
+     * After an augmentation along a shortest path to a target node:
+     *  - the potentials are updated with the distances capped to the distance of the target
+     *    (see shiftDistances()), so the new distances are known without any search;
+     *  - the saturated edges of the path are removed and the backward edges (reduced cost 0) are added
+     *    (see repair()): only the subtrees below the removed tree edges lose their distance, and they are
+     *    repaired with a Dijkstra limited to them (Ramalingam-Reps), seeded with the edges entering them.
+     * No edge of the graph is rewritten and the children of each node in the tree are kept in lists updated
+     * when a parent changes, so an augmentation only visits the nodes nearer than the target and the edges
+     * of the repaired subtrees, not all the nodes.
+     *
+     * (see: G. Ramalingam, T. Reps - On the computational complexity of dynamic graph problems, 1996)
+     */
+    class DynamicShortestPaths {
+        public:
+            /**
+             * Constructor, computes the shortest path tree from the source with Dijkstra.
+             *
+             * @param graph     the graph (it is not copied)
+             * @param source    the source node
+             * @param potential the potential of each node, the reduced costs must be non-negative (it is not copied)
+             */
+            DynamicShortestPaths(const std::shared_ptr<Graph>& graph, int source, std::vector<int>& potential);
+
+            /**
+             * Get the source of the shortest path tree.
+             *
+             * @return the source node
+             */
+            [[nodiscard]] int getSource() const;
+
+            /**
+             * Get the current distance of a node from the source.
+             *
+             * Time complexity: O(1)
+             *
+             * @param node the node
+             *
+             * @return the distance, std::numeric_limits<int>::max() if the node is not reachable
+             */
+            [[nodiscard]] int getDistance(int node) const;
+
+            /**
+             * Get the parent of each node in the shortest path tree (consts::source_parent for the source
+             * and the nodes not reachable). The reference is valid until the tree is destroyed, it changes with the tree.
+             *
+             * @return the parent of each node
+             */
+            [[nodiscard]] const std::vector<int>& getParent() const;
+
+            /**
+             * Get the path of the tree from the source to a reachable node.
+             *
+             * Time complexity: O(length of the path)
+             *
+             * @param target the node
+             *
+             * @return the nodes of the path, from the source to the target
+             */
+            [[nodiscard]] std::shared_ptr<std::vector<int>> getPath(int target) const;
+
+            /**
+             * Compute again the shortest path tree from a new source with Dijkstra (binary heap).
+             *
+             * V: number of nodes
+             * E: number of edges
+             * Time complexity: O(E * log(V))
+             *
+             * @param source the new source node
+             */
+            void reset(int source);
+
+            /**
+             * Subtract from the potential of each node its distance capped to the distance of the target,
+             * so the reduced cost of each edge u -> v grows by min(distance[u], distance[target]) - min(distance[v], distance[target]):
+             * it stays non-negative and the edges of the shortest path to the target get zero reduced cost.
+             * The shortest path tree does not change and the new distance of each node is
+             * max(0, distance - distance[target]).
+             * The potentials are defined up to a constant, so distance[target] is added back to all of them:
+             * only the nodes nearer than the target change potential, they are found walking the tree from the source.
+             * The distances of the other nodes drop by distance[target] with an offset shared by all of them.
+             *
+             * N: number of nodes nearer than the target
+             * C: number of their children in the tree
+             * Time complexity: O(N + C)
+             *
+             * @param target the node whose distance caps the distances
+             */
+            void shiftDistances(int target);
+
+            /**
+             * Repair the shortest path tree after sending flow along a path of the tree: the saturated edges of the path
+             * are removed from the graph and the backward edges of the path, with reduced cost 0, are added.
+             * Only the nodes of the subtrees below the removed edges are visited.
+             *
+             * A: number of nodes below the removed edges
+             * E(A): number of edges entering or leaving them
+             * Time complexity: O(E(A) * log(A))
+             *
+             * @param path the path of the tree (from the source) where the flow was sent
+             */
+            void repair(const std::shared_ptr<std::vector<int>>& path);
+
+        private:
+            /**
+             * Get the reduced cost of an edge with the current potentials.
+             *
+             * @param source the source of the edge
+             * @param edge   the edge
+             *
+             * @return the reduced cost of the edge
+             */
+            [[nodiscard]] int getReducedCost(int source, const Edge& edge) const;
+
+            /**
+             * Set the parent of a node in the tree, moving the node to the list of the children of the new parent.
+             *
+             * Time complexity: O(1)
+             *
+             * @param node   the node
+             * @param parent the new parent (consts::source_parent to detach the node)
+             */
+            void setParent(int node, int parent);
+
+            /**
+             * Dijkstra from the nodes in the queue, the edges are relaxed only towards the allowed nodes
+             * (all the nodes if allowed is empty).
+             *
+             * @param queue   the nodes with their tentative distance (with the offset of the distances)
+             * @param allowed the nodes whose distance can change
+             */
+            void search(std::priority_queue<std::pair<long long, int>, std::vector<std::pair<long long, int>>, std::greater<>>& queue,
+                        const std::vector<bool>& allowed);
+
+            // the graph (shared with the caller)
+            std::shared_ptr<Graph> graph;
+
+            // the potential of each node (owned by the caller)
+            std::vector<int>& potential;
+
+            // nodes adjacent to each node in either direction: the edges entering a node can only come from them,
+            // since the graph only gets the backward edges of its edges
+            std::vector<std::vector<int>> neighbors;
+
+            int source;
+
+            // distance of each node plus the offset (unreachable_distance if the node is not reachable)
+            std::vector<long long> distance;
+
+            // subtracted from the stored distances, grows at each shift (see shiftDistances())
+            long long distance_offset;
+
+            std::vector<int> parent;
+
+            // children of each node in the tree, as a doubly linked list of siblings (-1 at the ends)
+            std::vector<int> first_child;
+            std::vector<int> next_sibling;
+            std::vector<int> previous_sibling;
+
+            // scratch of repair(), all false between the calls
+            std::vector<bool> affected;
+
+            // stored distance of the nodes not reachable
+            static constexpr long long unreachable_distance { std::numeric_limits<long long>::max() };
+    };
+}
+
+#endif //NETWORK_FLOWS_DYNAMICSHORTESTPATHS_H
@@ -0,0 +1,28 @@
+#ifndef NETWORK_FLOWS_FLOWGRAPH_H
+#define NETWORK_FLOWS_FLOWGRAPH_H
+
+#include <concepts>
+
+namespace data_structures {
+    /**
+     * Concept of a residual network, what the generic flow algorithms need from a graph representation
+     * (see FlowGraphAlgorithms.h):
+     *  - getNumNodes(): the number of nodes, identified by 0, 1, ..., getNumNodes() - 1;
+     *  - forEachResidualNeighbor(node, visitor): call visitor(v) for each node v reachable from node
+     *    with a residual edge of positive capacity (a node can be visited more than once);
+     *  - getResidualCapacity(source, sink): the residual capacity from source to sink (0 if there is no residual edge),
+     *    of any integer type (the flows sent by the algorithms have the same type);
+     *  - push(source, sink, flow): send flow on the residual edge source -> sink, the capacity moves to sink -> source.
+     * The algorithms are templates over the concept, so each representation (adjacency lists, dense matrices,
+     * fixed-size matrices, ...) gets its own inlined version of them.
+     */
+    template<typename G>
+    concept FlowGraph = requires(G& graph, const G& const_graph, int node, int source, int sink) {
+        { const_graph.getNumNodes() } -> std::convertible_to<int>;
+        const_graph.forEachResidualNeighbor(node, [](int) {});
+        { const_graph.getResidualCapacity(source, sink) } -> std::integral;
+        graph.push(source, sink, const_graph.getResidualCapacity(source, sink));
+    };
+}
+
+#endif //NETWORK_FLOWS_FLOWGRAPH_H
@@ -0,0 +1,43 @@
+#include "ResidualGraphView.h"
+
+#include <utility>
+#include <stdexcept>
+
+namespace data_structures {
+    ResidualGraphView::ResidualGraphView(std::shared_ptr<Graph> residual_graph) :
+        residual_graph(std::move(residual_graph)) {}
+
+    int ResidualGraphView::getNumNodes() const {
+        return this->residual_graph->getNumNodes();
+    }
+
+    int ResidualGraphView::getResidualCapacity(int source, int sink) const {
+        return this->residual_graph->hasEdge(source, sink) ? this->residual_graph->getEdgeUnchecked(source, sink).getCapacity() : 0;
+    }
+
+    void ResidualGraphView::push(int source, int sink, int flow) {
+        // the edge is read and updated in place with a single lookup
+        auto& edge = this->residual_graph->getMutableEdgeUnchecked(source, sink);
+        int capacity { edge.getCapacity() };
+        int cost { edge.getCost() };
+        if (capacity < flow) {
+            throw std::invalid_argument("The flow is greater than the residual capacity of the edge");
+        }
+
+        if (capacity == flow) {
+            this->residual_graph->removeEdgeUnchecked(source, sink);
+        } else {
+            edge.setCapacity(capacity - flow);
+        }
+
+        if (!flow) {
+            return;
+        }
+        if (this->residual_graph->hasEdge(sink, source)) {
+            auto& reverse_edge = this->residual_graph->getMutableEdgeUnchecked(sink, source);
+            reverse_edge.setCapacity(reverse_edge.getCapacity() + flow);
+        } else {
+            this->residual_graph->addEdge(sink, source, flow, -cost);
+        }
+    }
+}
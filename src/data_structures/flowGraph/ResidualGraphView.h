@@ -0,0 +1,77 @@
+#ifndef NETWORK_FLOWS_RESIDUALGRAPHVIEW_H
+#define NETWORK_FLOWS_RESIDUALGRAPHVIEW_H
+
+#include "data_structures/graph/Graph.h"
+#include "data_structures/flowGraph/FlowGraph.h"
+
+#include <memory>
+
+namespace data_structures {
+    /**
+     * View of a residual graph stored with adjacent lists (see GraphUtils::GetResidualGraph()) as a FlowGraph.
+     * The edges of the residual graph are the residual edges: an edge is removed when it is saturated
+     * and the backward edge u -> v of an edge v -> u with flow has cost minus the cost of the edge.
+     * The view does not copy the graph, the flow is pushed directly on it.
+     */
+    class ResidualGraphView {
+        public:
+            /**
+             * Constructor.
+             *
+             * @param residual_graph the residual graph (without anti-parallel edges)
+             */
+            explicit ResidualGraphView(std::shared_ptr<Graph> residual_graph);
+
+            /**
+             * Get the number of nodes of the residual graph.
+             *
+             * @return the number of nodes
+             */
+            [[nodiscard]] int getNumNodes() const;
+
+            /**
+             * Visit the sink of each edge leaving the node with positive capacity, in the order of the adjacent list.
+             *
+             * @param node    the node
+             * @param visitor the function called with each sink
+             */
+            template<typename Visitor>
+            void forEachResidualNeighbor(int node, Visitor&& visitor) const {
+                for (const auto& e : this->residual_graph->getNodeAdjListUnchecked(node)) {
+                    if (e.getCapacity() > 0) {
+                        visitor(e.getSink());
+                    }
+                }
+            }
+
+            /**
+             * Get the residual capacity of the edge source -> sink.
+             *
+             * @param source the source node
+             * @param sink   the sink node
+             *
+             * @return the capacity of the edge, 0 if there is no edge
+             */
+            [[nodiscard]] int getResidualCapacity(int source, int sink) const;
+
+            /**
+             * Send flow on the edge source -> sink: its capacity decreases (it is removed when saturated)
+             * and the capacity of the backward edge sink -> source increases (it is added if needed).
+             *
+             * @param source the source node
+             * @param sink   the sink node
+             * @param flow   the flow to send
+             *
+             * @throws invalid_argument if the flow is greater than the residual capacity of the edge
+             */
+            void push(int source, int sink, int flow);
+
+        private:
+            // the residual graph
+            std::shared_ptr<Graph> residual_graph;
+    };
+
+    static_assert(FlowGraph<ResidualGraphView>);
+}
+
+#endif //NETWORK_FLOWS_RESIDUALGRAPHVIEW_H
@@ -0,0 +1,39 @@
+#include "WideResidualGraph.h"
+
+#include <stdexcept>
+
+namespace data_structures {
+    WideResidualGraph::WideResidualGraph(int num_nodes) : residual(num_nodes) {}
+
+    void WideResidualGraph::addEdge(int source, int sink, long long capacity, bool undirected) {
+        if (source < 0 || source >= this->getNumNodes() || sink < 0 || sink >= this->getNumNodes()) {
+            throw std::invalid_argument("The nodes of the edge do not exist");
+        }
+        if (capacity < 0) {
+            throw std::invalid_argument("The capacity of the edge cannot be negative");
+        }
+
+        // the backward pair is always in the map, so the flow pushed on the edge can be pushed back
+        this->residual.at(source)[sink] += capacity;
+        this->residual.at(sink)[source] += undirected ? capacity : 0;
+    }
+
+    int WideResidualGraph::getNumNodes() const {
+        return static_cast<int>(this->residual.size());
+    }
+
+    long long WideResidualGraph::getResidualCapacity(int source, int sink) const {
+        auto it = this->residual.at(source).find(sink);
+        return it != this->residual.at(source).end() ? it->second : 0;
+    }
+
+    void WideResidualGraph::push(int source, int sink, long long flow) {
+        auto it = this->residual.at(source).find(sink);
+        if (it == this->residual.at(source).end() || it->second < flow) {
+            throw std::invalid_argument("The flow is greater than the residual capacity of the edge");
+        }
+
+        it->second -= flow;
+        this->residual.at(sink)[source] += flow;
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef NETWORK_FLOWS_WIDERESIDUALGRAPH_H
+#define NETWORK_FLOWS_WIDERESIDUALGRAPH_H
+
+#include "data_structures/flowGraph/FlowGraph.h"
+
+#include <map>
+#include <vector>
+
+namespace data_structures {
+    /**
+     * Residual network with 64-bit capacities, as a FlowGraph: the flows that do not fit in the capacities of a Graph
+     * (e.g. the capacities scaled by the parametric maximum flow) are computed on it.
+     * The residual capacity of each pair of nodes is kept in the map of the first node: the parallel edges are merged,
+     * an edge adds its capacity in its direction and an undirected edge in both directions.
+     */
+    class WideResidualGraph {
+        public:
+            /**
+             * Constructor, the network has no edges.
+             *
+             * @param num_nodes the number of nodes
+             */
+            explicit WideResidualGraph(int num_nodes);
+
+            /**
+             * Add an edge to the network.
+             *
+             * Time complexity: O(log(V))
+             *
+             * @param source     the source node
+             * @param sink       the sink node
+             * @param capacity   the capacity of the edge
+             * @param undirected true if the flow can go in both directions, sharing the capacity
+             *
+             * @throws invalid_argument if the nodes do not exist
+             * @throws invalid_argument if the capacity is negative
+             */
+            void addEdge(int source, int sink, long long capacity, bool undirected);
+
+            /**
+             * Get the number of nodes of the network.
+             *
+             * @return the number of nodes
+             */
+            [[nodiscard]] int getNumNodes() const;
+
+            /**
+             * Visit each node reachable from the node with a residual edge of positive capacity, in increasing order.
+             *
+             * @param node    the node
+             * @param visitor the function called with each node
+             */
+            template<typename Visitor>
+            void forEachResidualNeighbor(int node, Visitor&& visitor) const {
+                for (const auto& [sink, capacity] : this->residual.at(node)) {
+                    if (capacity > 0) {
+                        visitor(sink);
+                    }
+                }
+            }
+
+            /**
+             * Get the residual capacity from source to sink.
+             *
+             * Time complexity: O(log(V))
+             *
+             * @param source the source node
+             * @param sink   the sink node
+             *
+             * @return the residual capacity, 0 if there is no residual edge
+             */
+            [[nodiscard]] long long getResidualCapacity(int source, int sink) const;
+
+            /**
+             * Send flow from source to sink, the capacity moves to sink -> source.
+             *
+             * Time complexity: O(log(V))
+             *
+             * @param source the source node
+             * @param sink   the sink node
+             * @param flow   the flow to send
+             *
+             * @throws invalid_argument if the flow is greater than the residual capacity
+             */
+            void push(int source, int sink, long long flow);
+
+        private:
+            // residual capacity of each pair of nodes with an edge, in either direction
+            std::vector<std::map<int, long long>> residual;
+    };
+
+    static_assert(FlowGraph<WideResidualGraph>);
+}
+
+#endif //NETWORK_FLOWS_WIDERESIDUALGRAPH_H
@@ -2,11 +2,21 @@
 
 namespace data_structures {
     Edge::Edge(const int source, const int sink, const int capacity, const int cost) :
+            Edge(source, sink, capacity, cost, 0) {}
+
+    Edge::Edge(const int source, const int sink, const int capacity, const int cost, const int lower_bound) :
+            id(-1),
             source(source),
             sink(sink),
             capacity(capacity),
-            cost(cost) {}
+            cost(cost),
+            lower_bound(lower_bound),
+            undirected(false) {}
+
 
+    int Edge::getId() const {
+        return this->id;
+    }
 
     int Edge::getSource() const {
         return this->source;
@@ -24,6 +34,18 @@ namespace data_structures {
         return this->cost;
     }
 
+    int Edge::getLowerBound() const {
+        return this->lower_bound;
+    }
+
+    bool Edge::isUndirected() const {
+        return this->undirected;
+    }
+
+    void Edge::setId(int new_id) {
+        this->id = new_id;
+    }
+
     void Edge::setCapacity(int new_capacity) {
         this->capacity = new_capacity;
     }
@@ -32,12 +54,31 @@ namespace data_structures {
         this->cost = new_cost;
     }
 
+    void Edge::setLowerBound(int new_lower_bound) {
+        this->lower_bound = new_lower_bound;
+    }
+
+    void Edge::setUndirected(bool new_undirected) {
+        this->undirected = new_undirected;
+    }
+
     std::string Edge::toString() const {
         std::string s = "{";
+        // the id is printed only when assigned by a graph
+        if (this->id >= 0) {
+            s += "\"Id\": " + std::to_string(this->id) + ", ";
+        }
         s += "\"Source\": " + std::to_string(this->source) + ", ";
         s += "\"Sink\": " + std::to_string(this->sink) + ", ";
         s += "\"Capacity\": " + std::to_string(this->capacity) + ", ";
         s += "\"Cost\": " + std::to_string(this->cost);
+        // the lower bound is printed only when set, like in the input format
+        if (this->lower_bound) {
+            s += ", \"Lower_bound\": " + std::to_string(this->lower_bound);
+        }
+        if (this->undirected) {
+            s += ", \"Undirected\": true";
+        }
         s += "}";
         return s;
     }
@@ -47,7 +88,8 @@ namespace data_structures {
             return true;
         }
         return this->source == other.source && this->sink == other.sink 
-            && this->capacity == other.capacity && this->cost == other.cost;
+            && this->capacity == other.capacity && this->cost == other.cost
+            && this->lower_bound == other.lower_bound && this->undirected == other.undirected;
     }
 
     bool Edge::operator!=(const Edge& other) const {
@@ -11,7 +11,14 @@ namespace data_structures {
      *  - source (the start node)
      *  - sink (the end node)
      *  - capacity (maximum amount that can flow on the edge)
-     *  - weight (weight per unit flow on the edge).
+     *  - weight (weight per unit flow on the edge)
+     *  - lower bound (minimum amount that must flow on the edge, 0 by default)
+     *  - id (dense identifier assigned by the graph when the edge is added, -1 before)
+     *  - undirected (optional, the capacity is shared by both directions, false by default).
+     * The cost segments of a convex piecewise-linear cost are kept by the graph, by edge id (see Graph::getCostSegments()),
+     * so the edges with a linear cost, almost all of them, do not pay for them.
+     * An undirected edge is stored once, from source to sink: the flow can go in both directions, the capacity
+     * and the cost per unit flow are the same in both of them.
      */
     class Edge {
     public:
@@ -25,6 +32,26 @@ namespace data_structures {
          */
         Edge(int source, int sink, int capacity, int cost);
 
+        /**
+         * Edge constructor with a lower bound on the flow.
+         *
+         * @param source      The source of the edge
+         * @param sink        The sink of the edge
+         * @param capacity    The capacity of the edge
+         * @param cost        The cost of the edge
+         * @param lower_bound The minimum flow that must be sent on the edge
+         */
+        Edge(int source, int sink, int capacity, int cost, int lower_bound);
+
+        /**
+         * Get the id of the edge.
+         * The id is assigned by the graph (see Graph::addEdge()) and it is kept by the copies of the edge,
+         * so the edges of the results (e.g. the optimal graph) have the id of the original edge.
+         *
+         * @return the id of the edge, -1 if it was not added to a graph
+         */
+        [[nodiscard]] int getId() const;
+
         /**
          * Get the source of the edge.
          *
@@ -53,6 +80,27 @@ namespace data_structures {
          */
         [[nodiscard]] int getCost() const;
 
+        /**
+         * Get the lower bound of the edge.
+         *
+         * @return the minimum flow that must be sent on the edge
+         */
+        [[nodiscard]] int getLowerBound() const;
+
+        /**
+         * Check if the edge is undirected.
+         *
+         * @return true if the flow can go in both directions, false otherwise
+         */
+        [[nodiscard]] bool isUndirected() const;
+
+        /**
+         * Set the id of the edge.
+         *
+         * @param new_id the new id of the edge
+         */
+        void setId(int new_id);
+
         /**
          * Set the capacity of the edge.
          *
@@ -67,6 +115,20 @@ namespace data_structures {
          */
         void setCost(int new_cost);
 
+        /**
+         * Set the lower bound of the edge.
+         *
+         * @param new_lower_bound the new lower bound of the edge
+         */
+        void setLowerBound(int new_lower_bound);
+
+        /**
+         * Set if the edge is undirected.
+         *
+         * @param new_undirected true if the flow can go in both directions
+         */
+        void setUndirected(bool new_undirected);
+
         /**
          * Print the edge in JSON format.
          */
@@ -91,10 +153,13 @@ namespace data_structures {
         bool operator!=(const Edge& other) const;
 
     private:
+        int id; // id of the edge
         int source; // source of the edge
         int sink; // sink of the edge
         int capacity; // capacity of the edge
         int cost; // cost of the edge
+        int lower_bound; // minimum flow on the edge
+        bool undirected; // true if the flow can go in both directions
     };
 }
 
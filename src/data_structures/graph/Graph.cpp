@@ -1,5 +1,9 @@
 #include "Graph.h"
 
+#include "consts/Consts.h"
+
+#include <limits>
+#include <algorithm>
 #include <stdexcept>
 #include <utils/json.hpp>
 
@@ -7,39 +11,68 @@ using json = nlohmann::ordered_json;
 
 namespace data_structures {
 
-    Graph::Graph(int num_nodes) : num_nodes(num_nodes) {
-        this->g = std::make_shared<std::map<int, std::shared_ptr<std::vector<Edge>>>>();
+    Graph::Graph(int num_nodes) : Graph(num_nodes, false) {}
+
+    Graph::Graph(int num_nodes, bool multigraph) : Graph(num_nodes, multigraph, std::pmr::get_default_resource()) {}
+
+    Graph::Graph(int num_nodes, bool multigraph, std::pmr::memory_resource* resource) :
+        num_nodes(num_nodes),
+        multigraph(multigraph),
+        next_edge_id(0),
+        resource(resource),
+        current_num_nodes(0) {
+        this->g = std::allocate_shared<std::pmr::vector<std::shared_ptr<NodeBlock>>>(this->getAllocator());
 
         // insert the nodes
         for (int node = 0; node < num_nodes; node++) {
-            this->g->insert({node, std::make_shared<std::vector<Edge>>()});
+            this->insertNode(node);
         }
 
-        this->artificial_nodes = std::make_shared<std::map<int, Edge>>();
+        this->artificial_nodes = std::allocate_shared<std::pmr::map<int, Edge>>(this->getAllocator());
+        this->node_capacities = std::allocate_shared<std::pmr::map<int, int>>(this->getAllocator());
+        this->cost_segments = std::allocate_shared<std::pmr::map<int, std::shared_ptr<const std::vector<std::pair<int, int>>>>>(this->getAllocator());
     }
 
-    Graph::Graph(const std::shared_ptr<Graph> other) {
-        this->num_nodes = other->num_nodes;
-        this->g = std::make_shared<std::map<int, std::shared_ptr<std::vector<Edge>>>>();
-
-        // insert the nodes
-        for (int node = 0; node < other->getNumNodes(); node++) {
-            this->g->insert({node, std::make_shared<std::vector<Edge>>()});
-        }
-
-        // insert the edges
-        for (auto it : *other->g) {
-            int node = it.first;
-            auto adj_list = it.second;
-            for (auto edge : *adj_list) {
-                this->g->at(node)->push_back(edge);
+    Graph::Graph(const std::shared_ptr<Graph> other) :
+        num_nodes(other->num_nodes),
+        multigraph(other->multigraph),
+        next_edge_id(other->next_edge_id),
+        resource(other->resource),
+        node_capacities(other->node_capacities),
+        cost_segments(other->cost_segments),
+        g(other->g),
+        current_num_nodes(other->current_num_nodes),
+        artificial_nodes(other->artificial_nodes) {}
+
+    Graph::Graph(const std::shared_ptr<Graph> other, std::pmr::memory_resource* resource) :
+        num_nodes(other->num_nodes),
+        multigraph(other->multigraph),
+        next_edge_id(other->next_edge_id),
+        resource(resource),
+        current_num_nodes(other->current_num_nodes) {
+        // the blocks and the lists are copied one by one, a copy of the table would share them
+        this->g = std::allocate_shared<std::pmr::vector<std::shared_ptr<NodeBlock>>>(this->getAllocator(), other->g->size());
+        for (std::size_t b = 0; b < other->g->size(); b++) {
+            if (!other->g->at(b)) {
+                continue;
+            }
+            auto block = std::allocate_shared<NodeBlock>(this->getAllocator());
+            for (int i = 0; i < Graph::block_size; i++) {
+                if (const auto& adj_list = other->g->at(b)->at(i)) {
+                    block->at(i) = std::allocate_shared<std::pmr::vector<Edge>>(this->getAllocator(), adj_list->begin(), adj_list->end());
+                }
             }
+            this->g->at(b) = std::move(block);
         }
 
-        this->artificial_nodes = std::make_shared<std::map<int, Edge>>();
-        for (auto it : *other->artificial_nodes) {
-            this->artificial_nodes->insert({it.first, it.second});
-        }
+        this->artificial_nodes = std::allocate_shared<std::pmr::map<int, Edge>>(this->getAllocator(), *other->artificial_nodes);
+        this->node_capacities = std::allocate_shared<std::pmr::map<int, int>>(this->getAllocator(), *other->node_capacities);
+        this->cost_segments = std::allocate_shared<std::pmr::map<int, std::shared_ptr<const std::vector<std::pair<int, int>>>>>(
+            this->getAllocator(), *other->cost_segments);
+    }
+
+    std::pmr::memory_resource* Graph::getMemoryResource() const {
+        return this->resource;
     }
 
     int Graph::getStartingNumNodes() const {
@@ -47,33 +80,74 @@ namespace data_structures {
     }
 
     int Graph::getNumNodes() const {
-        return static_cast<int>(this->g->size());
+        return this->current_num_nodes;
+    }
+
+    bool Graph::isMultigraph() const {
+        return this->multigraph;
+    }
+
+    int Graph::getNumEdgeIds() const {
+        return this->next_edge_id;
+    }
+
+    [[maybe_unused]] std::shared_ptr<const std::pmr::map<int, std::shared_ptr<std::pmr::vector<Edge>>>> Graph::getGraph() const {
+        auto graph = std::allocate_shared<std::pmr::map<int, std::shared_ptr<std::pmr::vector<Edge>>>>(this->getAllocator());
+        for (std::size_t b = 0; b < this->g->size(); b++) {
+            for (int i = 0; this->g->at(b) && i < Graph::block_size; i++) {
+                if (const auto& adj_list = this->g->at(b)->at(i)) {
+                    graph->insert({ static_cast<int>(b) * Graph::block_size + i, adj_list });
+                }
+            }
+        }
+        return graph;
     }
 
-    [[maybe_unused]] std::shared_ptr<std::map<int, std::shared_ptr<std::vector<Edge>>>> Graph::getGraph() const {
-        return this->g;
+    std::shared_ptr<const std::pmr::vector<Edge>> Graph::getNodeAdjList(int node) const {
+        Graph::checkNodeExistence(node);
+
+        return *this->findAdjList(node);
     }
 
-    std::shared_ptr<std::vector<Edge>> Graph::getNodeAdjList(int node) const {
+    std::shared_ptr<std::pmr::vector<Edge>> Graph::getMutableNodeAdjList(int node) {
         Graph::checkNodeExistence(node);
 
-        return this->g->at(node);
+        this->getOwnedAdjList(node);
+        return *this->findAdjList(node);
     }
 
     bool Graph::hasEdge(int source, int sink) const {
-        if (this->g->find(source) == this->g->end() || this->g->find(sink) == this->g->end()) {
+        auto adj_list = this->findAdjList(source);
+        if (!adj_list || !this->findAdjList(sink)) {
             return false;
         }
-        return std::any_of(this->g->at(source)->begin(), this->g->at(source)->end(), [sink](Edge e) {
+        return std::any_of((*adj_list)->begin(), (*adj_list)->end(), [sink](const Edge& e) {
             return e.getSink() == sink;
         });
     }
 
+    const std::pmr::vector<Edge>& Graph::getNodeAdjListUnchecked(int node) const {
+        if constexpr (consts::audit) {
+            Graph::checkNodeExistence(node);
+        }
+
+        return *(*(*this->g)[node / Graph::block_size])[node % Graph::block_size];
+    }
+
     Edge Graph::getEdge(int source, int sink) const {
         Graph::checkNodeExistence(source);
         Graph::checkNodeExistence(sink);
 
-        for (auto e : *this->g->at(source)) {
+        return this->getEdgeUnchecked(source, sink);
+    }
+
+    const Edge& Graph::getEdgeUnchecked(int source, int sink) const {
+        if constexpr (consts::audit) {
+            Graph::checkNodeExistence(source);
+            Graph::checkNodeExistence(sink);
+        }
+
+        for (const auto& e : this->getNodeAdjListUnchecked(source)) {
             if (e.getSink() == sink) {
                 return e;
             }
@@ -87,31 +161,55 @@ namespace data_structures {
         Graph::checkNodeExistence(sink);
         Graph::checkNegativeCapacity(capacity);
 
-        for (auto &e : *this->g->at(source)) {
-            if (e.getSink() == sink) {
-                e.setCapacity(capacity);
-                return;
-            }
+        this->setEdgeCapacityUnchecked(source, sink, capacity);
+    }
+
+    void Graph::setEdgeCapacityUnchecked(int source, int sink, int capacity) {
+        if constexpr (consts::audit) {
+            Graph::checkNodeExistence(source);
+            Graph::checkNodeExistence(sink);
+            Graph::checkNegativeCapacity(capacity);
         }
-        
-        throw std::invalid_argument(data_structures::Graph::getNoEdgeString(source, sink));
+
+        this->getMutableEdgeUnchecked(source, sink).setCapacity(capacity);
     }
 
     void Graph::setEdgeCost(int source, int sink, int cost) {
         Graph::checkNodeExistence(source);
         Graph::checkNodeExistence(sink);
 
-        for (auto &e : *this->g->at(source)) {
+        this->setEdgeCostUnchecked(source, sink, cost);
+    }
+
+    void Graph::setEdgeCostUnchecked(int source, int sink, int cost) {
+        if constexpr (consts::audit) {
+            Graph::checkNodeExistence(source);
+            Graph::checkNodeExistence(sink);
+        }
+
+        this->getMutableEdgeUnchecked(source, sink).setCost(cost);
+    }
+
+    Edge& Graph::getMutableEdgeUnchecked(int source, int sink) {
+        if constexpr (consts::audit) {
+            Graph::checkNodeExistence(source);
+            Graph::checkNodeExistence(sink);
+        }
+
+        for (auto& e : this->getOwnedAdjList(source)) {
             if (e.getSink() == sink) {
-                e.setCost(cost);
-                return;
+                return e;
             }
         }
 
-        throw std::invalid_argument(data_structures::Graph::getNoEdgeString(source, sink));    
+        throw std::invalid_argument(data_structures::Graph::getNoEdgeString(source, sink));
     }
 
     void Graph::addEdge(Edge e) {
+        this->addEdge(e, nullptr);
+    }
+
+    void Graph::addEdge(Edge e, std::shared_ptr<const std::vector<std::pair<int, int>>> cost_segments) {
         int source { e.getSource() };
         int sink { e.getSink() };
 
@@ -122,24 +220,43 @@ namespace data_structures {
         }
 
         Graph::checkNegativeCapacity(e.getCapacity());
+        Graph::checkLowerBound(e.getLowerBound(), e.getCapacity());
+        if (cost_segments) {
+            Graph::checkCostSegments(e, *cost_segments);
+        }
+        Graph::checkUndirected(e, cost_segments != nullptr);
 
         // if the sink node does not exist create it
-        if (this->g->find(sink) == this->g->end()) {
-            this->g->insert({ sink, std::make_shared<std::vector<Edge>>() });
-        }
-             
+        this->insertNode(sink);
+
         // if it is the first source edge create the adj list
-        if (this->g->find(source) == this->g->end()) {
-            this->g->insert({ source, std::make_shared<std::vector<Edge>>() });
+        if (!this->findAdjList(source)) {
+            this->insertNode(source);
         } else {
-            // check if the edge already exists
-            if (this->hasEdge(source, sink)) {
+            // check if the edge already exists (parallel edges are allowed only in a multigraph)
+            if (!this->multigraph && this->hasEdge(source, sink)) {
                 std::string s = "edge " + std::to_string(source) + " -> " + std::to_string(sink) + " already exists";
                 throw std::invalid_argument(s);
             }
         }
 
-        this->g->at(source)->push_back(e);
+        // assign the id
+        if (e.getId() < 0) {
+            e.setId(this->next_edge_id);
+        }
+        this->next_edge_id = std::max(this->next_edge_id, e.getId() + 1);
+
+        // the cost of a convex edge is the cost of its first segment
+        if (cost_segments) {
+            e.setCost(cost_segments->front().second);
+            if (this->cost_segments.use_count() > 1) {
+                this->cost_segments = std::allocate_shared<std::pmr::map<int, std::shared_ptr<const std::vector<std::pair<int, int>>>>>(
+                    this->getAllocator(), *this->cost_segments);
+            }
+            (*this->cost_segments)[e.getId()] = std::move(cost_segments);
+        }
+
+        this->getOwnedAdjList(source).push_back(e);
     }
 
     void Graph::addEdge(int source, int sink, int capacity, int cost) {
@@ -151,13 +268,29 @@ namespace data_structures {
         Graph::checkNodeExistence(source);
         Graph::checkNodeExistence(sink);
 
-        auto adj_list = this->g->at(source);
+        this->removeEdgeUnchecked(source, sink);
+    }
 
-        for (unsigned i = 0; i < adj_list->size(); i++) {
-            auto e = adj_list->at(i);
-            if (e.getSink() == sink) {
-                // remove edge
-                adj_list->erase(adj_list->begin() + i);
+    void Graph::removeEdgeUnchecked(int source, int sink) {
+        if constexpr (consts::audit) {
+            Graph::checkNodeExistence(source);
+            Graph::checkNodeExistence(sink);
+        }
+
+        const auto& adj_list = this->getNodeAdjListUnchecked(source);
+
+        for (unsigned i = 0; i < adj_list.size(); i++) {
+            if (adj_list[i].getSink() == sink) {
+                // remove edge (from the list of this graph only), with its cost segments
+                if (this->cost_segments->count(adj_list[i].getId())) {
+                    if (this->cost_segments.use_count() > 1) {
+                        this->cost_segments = std::allocate_shared<std::pmr::map<int, std::shared_ptr<const std::vector<std::pair<int, int>>>>>(
+                            this->getAllocator(), *this->cost_segments);
+                    }
+                    this->cost_segments->erase(adj_list[i].getId());
+                }
+                auto& owned_adj_list = this->getOwnedAdjList(source);
+                owned_adj_list.erase(owned_adj_list.begin() + i);
                 return;
             }
         }
@@ -165,11 +298,64 @@ namespace data_structures {
         throw std::invalid_argument(data_structures::Graph::getNoEdgeString(source, sink));
     }
 
-    std::shared_ptr<std::map<int, Edge>> Graph::getArtificialNodesMap() const {
+    std::shared_ptr<const std::vector<std::pair<int, int>>> Graph::getCostSegments(int edge_id) const {
+        auto it = this->cost_segments->find(edge_id);
+        return it == this->cost_segments->end() ? nullptr : it->second;
+    }
+
+    bool Graph::hasCostSegments() const {
+        return !this->cost_segments->empty();
+    }
+
+    int Graph::getFlowCost(const Edge& e, int flow) const {
+        auto segments = this->cost_segments->empty() ? nullptr : this->getCostSegments(e.getId());
+        if (!segments) {
+            return e.getCost() * flow;
+        }
+
+        // fill the segments in order
+        int flow_cost {};
+        for (auto [width, segment_cost] : *segments) {
+            int segment_flow { std::min(flow, width) };
+            flow_cost += segment_flow * segment_cost;
+            flow -= segment_flow;
+        }
+        return flow_cost;
+    }
+
+    std::shared_ptr<const std::pmr::map<int, int>> Graph::getNodeCapacities() const {
+        return this->node_capacities;
+    }
+
+    bool Graph::hasNodeCapacity(int node) const {
+        return this->node_capacities->find(node) != this->node_capacities->end();
+    }
+
+    int Graph::getNodeCapacity(int node) const {
+        Graph::checkNodeExistence(node);
+
+        auto it = this->node_capacities->find(node);
+        return it == this->node_capacities->end() ? std::numeric_limits<int>::max() : it->second;
+    }
+
+    void Graph::setNodeCapacity(int node, int capacity) {
+        Graph::checkNodeExistence(node);
+        Graph::checkNegativeCapacity(capacity);
+
+        if (this->node_capacities.use_count() > 1) {
+            this->node_capacities = std::allocate_shared<std::pmr::map<int, int>>(this->getAllocator(), *this->node_capacities);
+        }
+        (*this->node_capacities)[node] = capacity;
+    }
+
+    std::shared_ptr<const std::pmr::map<int, Edge>> Graph::getArtificialNodesMap() const {
         return this->artificial_nodes;
     }
 
     void Graph::addArtificialNodes(int node, Edge edge) {
+        if (this->artificial_nodes.use_count() > 1) {
+            this->artificial_nodes = std::allocate_shared<std::pmr::map<int, Edge>>(this->getAllocator(), *this->artificial_nodes);
+        }
         this->artificial_nodes->insert({node, edge});
     }
 
@@ -178,17 +364,40 @@ namespace data_structures {
         s += "\"Edges\": [";
 
         // iterate over the adj list 
-        for (auto & it : *this->g) {
+        auto graph = this->getGraph();
+        for (auto & it : *graph) {
             auto adj_list = it.second; // adj list of the source node
             for (auto e : *adj_list) {
                 s += e.toString();
+
+                // the cost segments are printed inside the edge, like in the input format
+                if (auto segments = this->getCostSegments(e.getId())) {
+                    s.pop_back();
+                    s += ", \"Cost_segments\": [";
+                    for (auto [width, segment_cost] : *segments) {
+                        s += "{\"Capacity\": " + std::to_string(width) + ", \"Cost\": " + std::to_string(segment_cost) + "}, ";
+                    }
+                    s = s.substr(0, s.size() - 2);
+                    s += "]}";
+                }
                 s += ", ";
             }
         }
 
         // remove the last comma
         s = s.substr(0, s.size() - 2);
-        s += "]}";
+        s += "]";
+
+        // the node capacities are printed only when set, like in the input format
+        if (!this->node_capacities->empty()) {
+            s += ", \"Node_capacities\": [";
+            for (auto& [node, capacity] : *this->node_capacities) {
+                s += "{\"Node\": " + std::to_string(node) + ", \"Capacity\": " + std::to_string(capacity) + "}, ";
+            }
+            s = s.substr(0, s.size() - 2);
+            s += "]";
+        }
+        s += "}";
         
         // beautify the json
         s = json::parse(s).dump(4);
@@ -202,14 +411,24 @@ namespace data_structures {
         if (this->getNumNodes() != other.getNumNodes()) {
             return false;
         }
-        for (auto & it : *this->g) {
+        if (*this->node_capacities != *other.node_capacities) {
+            return false;
+        }
+        auto graph = this->getGraph();
+        for (auto & it : *graph) {
             int source = it.first;     // source node
             auto adj_list = it.second; // adj list of the source node
             for (auto e : *adj_list) {
                 if (!other.hasEdge(source, e.getSink())) {
                     return false;
                 }
-                if (other.getEdge(source, e.getSink()) != e) {
+                auto other_edge = other.getEdge(source, e.getSink());
+                if (other_edge != e) {
+                    return false;
+                }
+                auto segments = this->getCostSegments(e.getId());
+                auto other_segments = other.getCostSegments(other_edge.getId());
+                if (segments != other_segments && (!segments || !other_segments || *segments != *other_segments)) {
                     return false;
                 }
             }
@@ -232,7 +451,7 @@ namespace data_structures {
     }
     
     void Graph::checkNodeExistence(int node) const {
-        if (this->g->find(node) == this->g->end()) {
+        if (!this->findAdjList(node)) {
             throw std::invalid_argument(data_structures::Graph::getNoNodeString(node));
         }
     }
@@ -242,4 +461,108 @@ namespace data_structures {
             throw std::invalid_argument("capacity must be positive");
         }
     }
+
+    void Graph::checkLowerBound(int lower_bound, int capacity) {
+        if (lower_bound < 0 || lower_bound > capacity) {
+            throw std::invalid_argument("lower bound must be between 0 and the capacity");
+        }
+    }
+
+    void Graph::checkCostSegments(const Edge& e, const std::vector<std::pair<int, int>>& cost_segments) {
+        if (cost_segments.empty()) {
+            throw std::invalid_argument("cost segments must not be empty");
+        }
+
+        int total_width {};
+        for (unsigned i = 0; i < cost_segments.size(); i++) {
+            if (cost_segments.at(i).first <= 0) {
+                throw std::invalid_argument("cost segments must have positive capacity");
+            }
+            if (i && cost_segments.at(i).second < cost_segments.at(i - 1).second) {
+                throw std::invalid_argument("cost segments must have non-decreasing cost (convex cost)");
+            }
+            total_width += cost_segments.at(i).first;
+        }
+
+        if (total_width < e.getCapacity()) {
+            throw std::invalid_argument("cost segments must cover the capacity of the edge");
+        }
+    }
+
+    void Graph::checkUndirected(const Edge& e, bool has_cost_segments) {
+        if (e.isUndirected() && (e.getLowerBound() || has_cost_segments)) {
+            throw std::invalid_argument("undirected edges cannot have lower bound or cost segments");
+        }
+    }
+
+    std::pmr::polymorphic_allocator<> Graph::getAllocator() const {
+        return std::pmr::polymorphic_allocator<>(this->resource);
+    }
+
+    void Graph::detachGraph() {
+        // the table is copied, the blocks are still shared
+        if (this->g.use_count() > 1) {
+            this->g = std::allocate_shared<std::pmr::vector<std::shared_ptr<NodeBlock>>>(this->getAllocator(), *this->g);
+        }
+    }
+
+    Graph::NodeBlock& Graph::getOwnedBlock(int node) {
+        this->detachGraph();
+
+        std::size_t b { static_cast<std::size_t>(node / Graph::block_size) };
+        if (b >= this->g->size()) {
+            this->g->resize(b + 1);
+        }
+
+        // the block is copied, its lists are still shared
+        auto& block = this->g->at(b);
+        if (!block) {
+            block = std::allocate_shared<NodeBlock>(this->getAllocator());
+        } else if (block.use_count() > 1) {
+            block = std::allocate_shared<NodeBlock>(this->getAllocator(), *block);
+        }
+
+        return *block;
+    }
+
+    const std::shared_ptr<std::pmr::vector<Edge>>* Graph::findAdjList(int node) const {
+        if (node < 0 || node / Graph::block_size >= static_cast<int>(this->g->size())) {
+            return nullptr;
+        }
+
+        const auto& block = (*this->g)[node / Graph::block_size];
+        if (!block || !block->at(node % Graph::block_size)) {
+            return nullptr;
+        }
+        return &block->at(node % Graph::block_size);
+    }
+
+    void Graph::insertNode(int node) {
+        if (this->findAdjList(node)) {
+            return;
+        }
+
+        this->getOwnedBlock(node).at(node % Graph::block_size) = std::allocate_shared<std::pmr::vector<Edge>>(this->getAllocator());
+        this->current_num_nodes++;
+    }
+
+    std::pmr::vector<Edge>& Graph::getOwnedAdjList(int node) {
+        // nothing is shared: the list is reached with plain loads, the usual case of the solvers
+        if (this->g.use_count() == 1) {
+            const auto& block = (*this->g)[node / Graph::block_size];
+            if (block.use_count() == 1) {
+                const auto& adj_list = (*block)[node % Graph::block_size];
+                if (adj_list.use_count() == 1) {
+                    return *adj_list;
+                }
+            }
+        }
+
+        auto& adj_list = this->getOwnedBlock(node).at(node % Graph::block_size);
+        if (adj_list.use_count() > 1) {
+            adj_list = std::allocate_shared<std::pmr::vector<Edge>>(this->getAllocator(), *adj_list);
+        }
+
+        return *adj_list;
+    }
 }
@@ -2,15 +2,39 @@
 #define MINIMUM_COST_FLOWS_PROBLEM_GRAPH_H
 
 #include "data_structures/graph/Edge.h"
+#include "data_structures/traversalGraph/TraversalGraph.h"
 
 #include <map>
+#include <array>
 #include <vector>
 #include <memory>
 #include <string>
+#include <utility>
+#include <memory_resource>
 
 namespace data_structures {
     /**
      * Class representing a graph stored using adjacent list.
+     * Each edge gets a dense id (0, 1, 2, ... in insertion order) when it is added, the ids are never reused.
+     * A multigraph can have parallel edges (same source and sink), in that case the methods taking
+     * source and sink refer to the first of them.
+     * An undirected edge is stored only in the adjacent list of its source (see Edge.h).
+     * A node can have a capacity, the maximum flow that can go through it (unlimited by default).
+     * An edge can have a convex piecewise-linear cost, its cost segments are kept in a table of the graph by edge id
+     * (see getCostSegments()), so the edges with a linear cost are not larger.
+     * The copies are copy-on-write: a copy shares the adjacent lists (and the other maps) with the original graph,
+     * and a graph duplicates a list only when it modifies it, so copying is O(1).
+     * The lists are kept in blocks of block_size consecutive nodes, shared by the copies like the lists,
+     * so a change of a node costs at most the copy of the table of the blocks (V / block_size pointers),
+     * of the block of the node and of its list.
+     * The maps, the lists and their shared pointers are allocated from a memory resource (std::pmr), the default
+     * one unless the graph is created with another (e.g. a pool per solve); the copies and the graphs built
+     * by the solvers from a graph use its resource, which must outlive all of them.
+     * A graph and its copies share their resource: if they are used on several threads at the same time
+     * (e.g. the snapshots of a VersionedGraph) the resource must be thread-safe, like the default one or
+     * std::pmr::synchronized_pool_resource (std::pmr::monotonic_buffer_resource and unsynchronized_pool_resource are not).
+     * The parallel solvers never allocate on their threads from a resource of their input graph that is not
+     * known to be thread-safe (see MinimumCostFlowAlgorithms::SolveByComponents() and AsyncSolver).
      */
     class Graph {
         public:
@@ -21,13 +45,54 @@ namespace data_structures {
              */
             explicit Graph(int num_nodes);
 
+            /**
+             * Graph constructor.
+             *
+             * @param num_nodes  the starting number of nodes
+             * @param multigraph true if the graph can have parallel edges
+             */
+            Graph(int num_nodes, bool multigraph);
+
+            /**
+             * Graph constructor with the memory resource of its maps and lists.
+             *
+             * @param num_nodes  the starting number of nodes
+             * @param multigraph true if the graph can have parallel edges
+             * @param resource   the memory resource, it must outlive the graph and its copies
+             */
+            Graph(int num_nodes, bool multigraph, std::pmr::memory_resource* resource);
+
             /**
              * Create a copy of the input graph.
+             * The copy shares the adjacent lists with the input graph until one of them modifies them (copy-on-write).
+             *
+             * Time complexity: O(1)
              * 
              * @param other the graph to copy 
              */
             Graph(const std::shared_ptr<Graph> other);
 
+            /**
+             * Create a copy of the input graph in another memory resource.
+             * The copy does not share any map or list with the input graph, so the copy and the input graph
+             * can be used (and destroyed) on different threads even if their resources are not thread-safe.
+             *
+             * V: number of nodes
+             * E: number of edges
+             * Time complexity: O(V + E)
+             *
+             * @param other    the graph to copy
+             * @param resource the memory resource of the copy, it must outlive the copy and its copies
+             */
+            Graph(const std::shared_ptr<Graph> other, std::pmr::memory_resource* resource);
+
+            /**
+             * Get the memory resource of the graph, used by the copies and by the graphs built from it.
+             *
+             * @return the memory resource
+             */
+            [[nodiscard]] std::pmr::memory_resource* getMemoryResource() const;
+
             /**
              * Return the starting number of nodes of the graph.
              * The starting number of nodes is the number of nodes that the graph has when it is created.
@@ -48,14 +113,34 @@ namespace data_structures {
             [[nodiscard]] int getNumNodes() const;
 
             /**
-             * Get the graph.
+             * Check if the graph can have parallel edges.
+             *
+             * @return true if the graph is a multigraph, false otherwise
+             */
+            [[nodiscard]] bool isMultigraph() const;
+
+            /**
+             * Return the number of edge ids assigned so far.
+             * The ids of the edges are in [0, number of edge ids), the ids of the removed edges are not reused.
+             *
+             * @return the number of edge ids
+             */
+            [[nodiscard]] int getNumEdgeIds() const;
+
+            /**
+             * Get the graph, as a map from each node to its adjacent list.
+             * The map is built from the blocks of the lists, it shares the lists with the graph.
+             *
+             * V: number of nodes
+             * Time complexity: O(V * log(V))
              *
              * @return the graph
              */
-            [[maybe_unused]] [[nodiscard]] std::shared_ptr<std::map<int, std::shared_ptr<std::vector<Edge>>>> getGraph() const;
+            [[maybe_unused]] [[nodiscard]] std::shared_ptr<const std::pmr::map<int, std::shared_ptr<std::pmr::vector<Edge>>>> getGraph() const;
 
             /**
              * Get the adjacent list of the node i.
+             * The list can be shared with the copies of the graph, so it is read-only (see getMutableNodeAdjList()).
              *
              * @param node the node
              * 
@@ -63,7 +148,45 @@ namespace data_structures {
              * 
              * @throws invalid_argument if the node does not exist
              */
-            [[nodiscard]] std::shared_ptr<std::vector<Edge>> getNodeAdjList(int node) const;
+            [[nodiscard]] std::shared_ptr<const std::pmr::vector<Edge>> getNodeAdjList(int node) const;
+
+            /**
+             * Get the adjacent list of the node i to modify it in place.
+             * If the list is shared with a copy of the graph it is duplicated first (copy-on-write).
+             *
+             * @param node the node
+             *
+             * @return the adjacent list of the node u, owned only by this graph
+             *
+             * @throws invalid_argument if the node does not exist
+             */
+            [[nodiscard]] std::shared_ptr<std::pmr::vector<Edge>> getMutableNodeAdjList(int node);
+
+            /**
+             * Get the adjacent list of a node without checking that the node exists, for the inner loops
+             * of the solvers (the API functions check their input, then they only visit nodes of the graph).
+             * The reference is valid until the graph is modified.
+             * With NETWORK_FLOWS_AUDIT defined the node is checked (see consts::audit).
+             *
+             * @param node the node, it must exist
+             *
+             * @return the adjacent list of the node
+             */
+            [[nodiscard]] const std::pmr::vector<Edge>& getNodeAdjListUnchecked(int node) const;
+
+            /**
+             * Visit the arcs leaving a node without checking that the node exists (see getNodeAdjListUnchecked()),
+             * with the same interface of CompressedGraph::forEachArc() (see data_structures::TraversalGraph).
+             *
+             * @param node    the node, it must exist
+             * @param visitor the function called with the sink, the capacity and the cost of each arc
+             */
+            template<typename Visitor>
+            void forEachArc(int node, Visitor&& visitor) const {
+                for (const auto& e : this->getNodeAdjListUnchecked(node)) {
+                    visitor(e.getSink(), e.getCapacity(), e.getCost());
+                }
+            }
 
             /**
              * Check if the edge source -> tail exists.
@@ -90,6 +213,34 @@ namespace data_structures {
              */
             [[nodiscard]] data_structures::Edge getEdge(int source, int sink) const;
 
+            /**
+             * Get the edge between the nodes u and v without checking that the nodes exist (see getNodeAdjListUnchecked()).
+             * The reference is valid until the graph is modified.
+             *
+             * @param source the first node, it must exist
+             * @param sink   the second node, it must exist
+             *
+             * @return the edge between the nodes u and v
+             *
+             * @throws invalid_argument if the edge does not exist
+             */
+            [[nodiscard]] const data_structures::Edge& getEdgeUnchecked(int source, int sink) const;
+
+            /**
+             * Get the edge between the nodes u and v to modify it in place, without checking that the nodes exist
+             * (see getNodeAdjListUnchecked()): a read and a write of the edge cost a single lookup.
+             * The list of the source is copied first if it is shared with a copy of the graph (copy-on-write).
+             * The reference is valid until the graph is modified or copied.
+             *
+             * @param source the first node, it must exist
+             * @param sink   the second node, it must exist
+             *
+             * @return the edge between the nodes u and v
+             *
+             * @throws invalid_argument if the edge does not exist
+             */
+            [[nodiscard]] data_structures::Edge& getMutableEdgeUnchecked(int source, int sink);
+
             /**
              * Set the capacity of the edge between the nodes u and v.
              *
@@ -103,6 +254,18 @@ namespace data_structures {
              */
             void setEdgeCapacity(int source, int sink, int capacity);
 
+            /**
+             * Set the capacity of the edge between the nodes u and v without checking that the nodes exist
+             * and that the capacity is not negative (see getNodeAdjListUnchecked()).
+             *
+             * @param source   the first node, it must exist
+             * @param sink     the second node, it must exist
+             * @param capacity the new capacity of the edge, it must not be negative
+             *
+             * @throws invalid_argument if the edge does not exist
+             */
+            void setEdgeCapacityUnchecked(int source, int sink, int capacity);
+
             /**
              * Set the cost of the edge between the nodes u and v.
              *
@@ -116,18 +279,50 @@ namespace data_structures {
              */
             void setEdgeCost(int source, int sink, int cost);
 
+            /**
+             * Set the cost of the edge between the nodes u and v without checking that the nodes exist
+             * (see getNodeAdjListUnchecked()).
+             *
+             * @param source the first node, it must exist
+             * @param sink   the second node, it must exist
+             * @param cost   the new cost of the edge
+             *
+             * @throws invalid_argument if the edge does not exist
+             */
+            void setEdgeCostUnchecked(int source, int sink, int cost);
+
             /**
             * Add the direct edge e to the graph.
+            * If the edge has no id (-1), it gets the next id, else it keeps its id (e.g. a copy of an edge of
+            * another graph) and the next ids start after it.
             *
             * @param e The edge to add
             * 
             * @throws invalid_argument if the nodes are negative
-            * @throws invalid_argument if the edge already exists
+            * @throws invalid_argument if the edge already exists and the graph is not a multigraph
             * @throws invalid_argument if the nodes does not exist
             * @throws invalid_argument if the capacity is negative
+            * @throws invalid_argument if the lower bound is negative or greater than the capacity
+            * @throws invalid_argument if the edge is undirected and it has a lower bound or cost segments
             */
             void addEdge(Edge e);
 
+            /**
+             * Add the direct edge e to the graph with a convex piecewise-linear cost (see addEdge(Edge)).
+             * Each segment is a pair (width, cost per unit flow): the first width units of flow cost the cost
+             * of the first segment, the next ones the cost of the second segment, ...
+             * The costs of the segments must be non-decreasing, the cost of the edge becomes the cost of the first segment.
+             * The segments are shared, not copied, so the graphs built from a graph can reuse them.
+             *
+             * @param e             The edge to add
+             * @param cost_segments the (width, cost per unit flow) pairs of the cost, nullptr for a linear cost
+             *
+             * @throws invalid_argument if the edge is not valid (see addEdge(Edge))
+             * @throws invalid_argument if a segment has width <= 0, the costs are decreasing
+             *                          or the total width is less than the capacity
+             */
+            void addEdge(Edge e, std::shared_ptr<const std::vector<std::pair<int, int>>> cost_segments);
+
             /**
              * Add the direct edge source -> sink to the graph.
              *
@@ -137,7 +332,7 @@ namespace data_structures {
              * @param cost     the cost of the edge
              * 
              * @throws invalid_argument if the nodes are negative
-             * @throws invalid_argument if the edge already exists
+             * @throws invalid_argument if the edge already exists and the graph is not a multigraph
              * @throws invalid_argument if the capacity is negative
              */
             void addEdge(int source, int sink, int capacity, int cost);
@@ -153,6 +348,90 @@ namespace data_structures {
              */
             void removeEdge(int source, int sink);
 
+            /**
+             * Remove the direct edge source -> sink from the graph without checking that the nodes exist
+             * (see getNodeAdjListUnchecked()).
+             *
+             * @param source the source node, it must exist
+             * @param sink   the sink node, it must exist
+             *
+             * @throws invalid_argument if the edge does not exist
+             */
+            void removeEdgeUnchecked(int source, int sink);
+
+            /**
+             * Get the cost segments of an edge.
+             *
+             * Time complexity: O(log(number of edges with cost segments))
+             *
+             * @param edge_id the id of the edge
+             *
+             * @return the (width, cost per unit flow) pairs of the cost, nullptr if the cost is linear
+             */
+            [[nodiscard]] std::shared_ptr<const std::vector<std::pair<int, int>>> getCostSegments(int edge_id) const;
+
+            /**
+             * Check if the graph has edges with a convex piecewise-linear cost.
+             *
+             * Time complexity: O(1)
+             *
+             * @return true if an edge has cost segments, false otherwise
+             */
+            [[nodiscard]] bool hasCostSegments() const;
+
+            /**
+             * Get the total cost of sending the given flow on an edge of the graph.
+             * For a linear cost it is cost * flow, otherwise it is the sum of the costs of the segments filled by the flow.
+             *
+             * @param e    the edge
+             * @param flow the flow sent on the edge
+             *
+             * @return the cost of the flow
+             */
+            [[nodiscard]] int getFlowCost(const Edge& e, int flow) const;
+
+            /**
+             * Get the capacities of the nodes.
+             * The map has as:
+             *   - Key:   the node
+             *   - Value: the maximum flow that can go through the node
+             * The nodes without capacity are not in the map.
+             *
+             * @return the node capacities map
+             */
+            [[nodiscard]] std::shared_ptr<const std::pmr::map<int, int>> getNodeCapacities() const;
+
+            /**
+             * Check if the node has a capacity.
+             *
+             * @param node the node
+             *
+             * @return true if the flow through the node is limited, false otherwise
+             */
+            [[nodiscard]] bool hasNodeCapacity(int node) const;
+
+            /**
+             * Get the capacity of the node.
+             *
+             * @param node the node
+             *
+             * @return the maximum flow that can go through the node, std::numeric_limits<int>::max() if unlimited
+             *
+             * @throws invalid_argument if the node does not exist
+             */
+            [[nodiscard]] int getNodeCapacity(int node) const;
+
+            /**
+             * Set the capacity of the node.
+             *
+             * @param node     the node
+             * @param capacity the maximum flow that can go through the node
+             *
+             * @throws invalid_argument if the node does not exist
+             * @throws invalid_argument if the capacity is negative
+             */
+            void setNodeCapacity(int node, int capacity);
+
             /**
              * Get the artificial node map.
              * Artificial nodes are nodes that are added to the graph to handle anti-parallel edges.
@@ -165,7 +444,7 @@ namespace data_structures {
              * 
              * @return the artificial node map
              */
-            std::shared_ptr<std::map<int, Edge>> getArtificialNodesMap() const;
+            std::shared_ptr<const std::pmr::map<int, Edge>> getArtificialNodesMap() const;
 
             /**
              * Add the artificial node to the graph.
@@ -199,6 +478,12 @@ namespace data_structures {
              */
             bool operator!=(const Graph& other) const;
         private:
+            // number of consecutive nodes in a block of the adjacent lists
+            static constexpr int block_size { 256 };
+
+            // adjacent lists of block_size consecutive nodes (empty pointer for the nodes not in the graph)
+            using NodeBlock = std::array<std::shared_ptr<std::pmr::vector<Edge>>, block_size>;
+
             /**
              * Get the string representing the no-edge message between the nodes u and v.
              *
@@ -236,16 +521,118 @@ namespace data_structures {
              */
             static void checkNegativeCapacity(int capacity);
 
+            /**
+             * Check if the lower bound is between 0 and the capacity.
+             *
+             * @param lower_bound the lower bound
+             * @param capacity    the capacity
+             * 
+             * @throws invalid_argument if the lower bound is negative or greater than the capacity
+             */
+            static void checkLowerBound(int lower_bound, int capacity);
+
+            /**
+             * Check if the cost segments describe a convex cost covering the capacity of the edge.
+             *
+             * @param e             the edge
+             * @param cost_segments the cost segments of the edge
+             *
+             * @throws invalid_argument if a segment has width <= 0, the costs are decreasing
+             *                          or the total width is less than the capacity
+             */
+            static void checkCostSegments(const Edge& e, const std::vector<std::pair<int, int>>& cost_segments);
+
+            /**
+             * Check if the undirected edge has only capacity and cost (the lower bound and the cost segments
+             * would depend on the direction of the flow).
+             *
+             * @param e                 the edge
+             * @param has_cost_segments true if the edge has cost segments
+             *
+             * @throws invalid_argument if the edge is undirected and it has a lower bound or cost segments
+             */
+            static void checkUndirected(const Edge& e, bool has_cost_segments);
+
+            /**
+             * Get the allocator of the maps and the lists of the graph.
+             *
+             * @return the allocator using the memory resource of the graph
+             */
+            [[nodiscard]] std::pmr::polymorphic_allocator<> getAllocator() const;
+
+            /**
+             * Make the table of the blocks owned only by this graph (copy-on-write),
+             * the blocks and the lists are still shared.
+             */
+            void detachGraph();
+
+            /**
+             * Get the block of a node owned only by this graph (copy-on-write), created if the node has no block.
+             * The lists of the block are still shared.
+             *
+             * @param node the node (non-negative)
+             *
+             * @return the block of the node
+             */
+            NodeBlock& getOwnedBlock(int node);
+
+            /**
+             * Get the adjacent list of a node, if the node exists.
+             *
+             * @param node the node
+             *
+             * @return the slot of the list of the node in its block, nullptr if the node does not exist
+             */
+            [[nodiscard]] const std::shared_ptr<std::pmr::vector<Edge>>* findAdjList(int node) const;
+
+            /**
+             * Add a node without edges, if it does not exist.
+             *
+             * @param node the node (non-negative)
+             */
+            void insertNode(int node);
+
+            /**
+             * Get the adjacent list of an existing node owned only by this graph (copy-on-write).
+             * If the table, the block and the list are not shared the list is returned without copying any pointer.
+             *
+             * @param node the node
+             *
+             * @return the adjacent list of the node
+             */
+            std::pmr::vector<Edge>& getOwnedAdjList(int node);
+
             // the starting number of nodes of the graph
             int num_nodes;
 
-            // graph represented using map of adjacent list
-            std::shared_ptr<std::map<int, std::shared_ptr<std::vector<Edge>>>> g;
+            // true if the graph can have parallel edges
+            bool multigraph;
+
+            // id of the next edge added
+            int next_edge_id;
+
+            // memory resource of the maps and the lists (shared with the copies)
+            std::pmr::memory_resource* resource;
+
+            // capacity of the nodes with limited flow
+            std::shared_ptr<std::pmr::map<int, int>> node_capacities;
+
+            // cost segments of the edges with a convex cost, by edge id (shared with the copies until modified)
+            std::shared_ptr<std::pmr::map<int, std::shared_ptr<const std::vector<std::pair<int, int>>>>> cost_segments;
+
+            // graph represented using adjacent lists in blocks of nodes (the table, the blocks and the lists
+            // are shared with the copies until modified)
+            std::shared_ptr<std::pmr::vector<std::shared_ptr<NodeBlock>>> g;
+
+            // number of nodes of the graph (the nodes without a list in the blocks are not in the graph)
+            int current_num_nodes;
 
             // map of artificial nodes
             // artificial nodes are used for anti-parallel edges
             // Key: artificial node / Value: the substitute edge
-            std::shared_ptr<std::map<int, Edge>> artificial_nodes;
+            std::shared_ptr<std::pmr::map<int, Edge>> artificial_nodes;
     };
+
+    static_assert(TraversalGraph<Graph>);
 }
 #endif //MINIMUM_COST_FLOWS_PROBLEM_GRAPH_H
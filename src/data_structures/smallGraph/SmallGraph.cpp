@@ -0,0 +1,124 @@
+#include "SmallGraph.h"
+
+#include <bit>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+namespace data_structures {
+    bool SmallGraph::IsSupported(const std::shared_ptr<Graph>& graph) {
+        if (graph->getNumNodes() > SmallGraph::max_nodes || !graph->getNodeCapacities()->empty()) {
+            return false;
+        }
+
+        for (int u = 0; u < graph->getNumNodes(); u++) {
+            for (const auto& e : *graph->getNodeAdjList(u)) {
+                if (e.getLowerBound() || e.isUndirected()) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    SmallGraph::SmallGraph(const std::shared_ptr<Graph>& graph) :
+        num_nodes(graph->getNumNodes()),
+        capacity(),
+        residual(),
+        residual_adj() {
+        if (!SmallGraph::IsSupported(graph)) {
+            throw std::invalid_argument("The graph cannot be represented by a small graph");
+        }
+
+        for (int u = 0; u < this->num_nodes; u++) {
+            for (const auto& e : *graph->getNodeAdjList(u)) {
+                this->capacity[u][e.getSink()] += e.getCapacity();
+            }
+        }
+
+        // the residual graph starts with the flow at zero
+        for (int u = 0; u < this->num_nodes; u++) {
+            for (int v = 0; v < this->num_nodes; v++) {
+                this->setResidualCapacity(u, v, this->capacity[u][v]);
+            }
+        }
+    }
+
+    int SmallGraph::maxFlow(int source, int sink) {
+        if (source < 0 || source >= this->num_nodes || sink < 0 || sink >= this->num_nodes) {
+            throw std::invalid_argument("The source and the sink must be nodes of the graph");
+        }
+        if (source == sink) {
+            return 0;
+        }
+
+        int max_flow {};
+        std::array<int, SmallGraph::max_nodes> parent {};
+        while (this->findShortestPath(source, sink, parent)) {
+            // bottleneck of the path
+            int flow { std::numeric_limits<int>::max() };
+            for (int v = sink; v != source; v = parent[v]) {
+                flow = std::min(flow, this->residual[parent[v]][v]);
+            }
+
+            for (int v = sink; v != source; v = parent[v]) {
+                this->push(parent[v], v, flow);
+            }
+
+            max_flow += flow;
+        }
+
+        return max_flow;
+    }
+
+    int SmallGraph::getFlow(int source, int sink) const {
+        return this->capacity[source][sink] - this->residual[source][sink];
+    }
+
+    int SmallGraph::getNumNodes() const {
+        return this->num_nodes;
+    }
+
+    int SmallGraph::getResidualCapacity(int source, int sink) const {
+        return this->residual[source][sink];
+    }
+
+    void SmallGraph::push(int source, int sink, int flow) {
+        this->setResidualCapacity(source, sink, this->residual[source][sink] - flow);
+        this->setResidualCapacity(sink, source, this->residual[sink][source] + flow);
+    }
+
+    bool SmallGraph::findShortestPath(int source, int sink, std::array<int, max_nodes>& parent) const {
+        std::uint64_t visited { std::uint64_t{1} << source };
+        std::uint64_t frontier { visited };
+        std::uint64_t sink_bit { std::uint64_t{1} << sink };
+
+        // visit one level of the BFS at a time, the nodes reached from a node are the bits of its residual edges not visited yet
+        while (frontier && !(visited & sink_bit)) {
+            std::uint64_t next {};
+            for (std::uint64_t nodes = frontier; nodes; nodes &= nodes - 1) {
+                int u { std::countr_zero(nodes) };
+                std::uint64_t reached { this->residual_adj[u] & ~visited };
+                visited |= reached;
+                next |= reached;
+
+                for (; reached; reached &= reached - 1) {
+                    parent[std::countr_zero(reached)] = u;
+                }
+            }
+            frontier = next;
+        }
+
+        return visited & sink_bit;
+    }
+
+    void SmallGraph::setResidualCapacity(int source, int sink, int capacity) {
+        this->residual[source][sink] = capacity;
+        if (capacity > 0) {
+            this->residual_adj[source] |= std::uint64_t{1} << sink;
+        } else {
+            this->residual_adj[source] &= ~(std::uint64_t{1} << sink);
+        }
+    }
+}
@@ -0,0 +1,148 @@
+#ifndef NETWORK_FLOWS_SMALLGRAPH_H
+#define NETWORK_FLOWS_SMALLGRAPH_H
+
+#include "data_structures/graph/Graph.h"
+#include "data_structures/flowGraph/FlowGraph.h"
+
+#include <bit>
+#include <array>
+#include <memory>
+#include <cstdint>
+
+namespace data_structures {
+    /**
+     * Fixed-size representation of a graph with at most max_nodes nodes, used to solve tiny maximum flow instances
+     * without the overhead of the general graph (maps, shared pointers, heap allocated paths).
+     * The capacities are stored in a matrix (the parallel edges are merged, the anti-parallel edges need no artificial nodes)
+     * and the residual graph is a matrix of residual capacities plus a bitmask of the residual edges of each node,
+     * so a BFS visits a whole level of the graph with a few word operations.
+     * The object lives on the stack: neither the construction nor the solve allocate memory.
+     * It is a FlowGraph, so the generic algorithms can also run on it (see FlowGraphAlgorithms.h).
+     */
+    class SmallGraph {
+        public:
+            // maximum number of nodes (one bit per node in the adjacency bitmasks)
+            static constexpr int max_nodes { 64 };
+
+            /**
+             * Check if a graph can be represented by a small graph: at most max_nodes nodes,
+             * no lower bounds, no undirected edges and no node capacities.
+             *
+             * @param graph the graph to check
+             *
+             * @return true if the graph can be represented, false otherwise
+             */
+            static bool IsSupported(const std::shared_ptr<Graph>& graph);
+
+            /**
+             * Constructor, the flow starts at zero.
+             *
+             * @param graph the graph (see IsSupported())
+             *
+             * @throws invalid_argument if the graph cannot be represented by a small graph
+             */
+            explicit SmallGraph(const std::shared_ptr<Graph>& graph);
+
+            /**
+             * Edmonds-Karp algorithm on the matrix: the shortest augmenting paths are found with a bitmask BFS.
+             * The flow is augmented from the current one.
+             *
+             * V: number of nodes
+             * E: number of edges
+             * Time complexity: O(V * E * V^2 / 64)
+             *
+             * @param source the source node
+             * @param sink   the sink node
+             *
+             * @return the flow sent from source to sink
+             *
+             * @throws invalid_argument if the source or the sink is not a node of the graph
+             */
+            int maxFlow(int source, int sink);
+
+            /**
+             * Get the net flow sent from source to sink by the edges between them.
+             *
+             * @param source the source node
+             * @param sink   the sink node
+             *
+             * @return the net flow (negative if the flow goes from sink to source)
+             */
+            [[nodiscard]] int getFlow(int source, int sink) const;
+
+            /**
+             * Get the number of nodes.
+             *
+             * @return the number of nodes
+             */
+            [[nodiscard]] int getNumNodes() const;
+
+            /**
+             * Visit each node reachable from the node with a residual edge, in increasing order.
+             *
+             * @param node    the node
+             * @param visitor the function called with each node
+             */
+            template<typename Visitor>
+            void forEachResidualNeighbor(int node, Visitor&& visitor) const {
+                for (std::uint64_t nodes = this->residual_adj[node]; nodes; nodes &= nodes - 1) {
+                    visitor(std::countr_zero(nodes));
+                }
+            }
+
+            /**
+             * Get the residual capacity from source to sink.
+             *
+             * @param source the source node
+             * @param sink   the sink node
+             *
+             * @return the residual capacity
+             */
+            [[nodiscard]] int getResidualCapacity(int source, int sink) const;
+
+            /**
+             * Send flow from source to sink on the residual edge between them.
+             *
+             * @param source the source node
+             * @param sink   the sink node
+             * @param flow   the flow to send (at most the residual capacity)
+             */
+            void push(int source, int sink, int flow);
+
+        private:
+            /**
+             * Find the shortest path source -> sink in the residual graph (bitmask BFS).
+             *
+             * @param source the source node
+             * @param sink   the sink node
+             * @param parent the parent of each node in the BFS tree (output)
+             *
+             * @return true if the sink is reachable, false otherwise
+             */
+            bool findShortestPath(int source, int sink, std::array<int, max_nodes>& parent) const;
+
+            /**
+             * Set the residual capacity of an edge, keeping the adjacency bitmask aligned.
+             *
+             * @param source   the source node
+             * @param sink     the sink node
+             * @param capacity the new residual capacity
+             */
+            void setResidualCapacity(int source, int sink, int capacity);
+
+            int num_nodes;
+
+            // capacity of each pair of nodes (sum of the parallel edges)
+            std::array<std::array<int, max_nodes>, max_nodes> capacity;
+
+            // residual capacity of each pair of nodes
+            std::array<std::array<int, max_nodes>, max_nodes> residual;
+
+            // bit v of residual_adj[u] is set if the residual capacity of u -> v is positive
+            std::array<std::uint64_t, max_nodes> residual_adj;
+    };
+
+    static_assert(FlowGraph<SmallGraph>);
+}
+
+#endif //NETWORK_FLOWS_SMALLGRAPH_H
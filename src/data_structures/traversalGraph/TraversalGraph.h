@@ -0,0 +1,22 @@
+#ifndef NETWORK_FLOWS_TRAVERSALGRAPH_H
+#define NETWORK_FLOWS_TRAVERSALGRAPH_H
+
+#include <concepts>
+
+namespace data_structures {
+    /**
+     * Concept of a graph that can be traversed, what BFS and Dijkstra need from a graph representation
+     * (see GraphBaseAlgorithms.h):
+     *  - getNumNodes(): the number of nodes, identified by 0, 1, ..., getNumNodes() - 1;
+     *  - forEachArc(node, visitor): call visitor(sink, capacity, cost) for each arc leaving node.
+     * The adjacency lists (see Graph.h) and the compressed adjacency (see CompressedGraph.h) satisfy it,
+     * so the traversals are written once and each representation gets its own inlined version of them.
+     */
+    template<typename G>
+    concept TraversalGraph = requires(const G& graph, int node) {
+        { graph.getNumNodes() } -> std::convertible_to<int>;
+        graph.forEachArc(node, [](int, int, int) {});
+    };
+}
+
+#endif //NETWORK_FLOWS_TRAVERSALGRAPH_H
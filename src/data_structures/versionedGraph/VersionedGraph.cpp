@@ -0,0 +1,61 @@
+#include "VersionedGraph.h"
+
+#if defined(__SANITIZE_THREAD__)
+#define NETWORK_FLOWS_TSAN
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define NETWORK_FLOWS_TSAN
+#endif
+#endif
+
+#ifdef NETWORK_FLOWS_TSAN
+// libstdc++ guards the pointer of std::atomic<std::shared_ptr> with a lock bit in its reference count word,
+// ThreadSanitizer does not see that lock and reports the accesses to the pointer as races (false positive)
+extern "C" const char* __tsan_default_suppressions() {
+    return "race:std::_Sp_atomic\n";
+}
+#endif
+
+namespace data_structures {
+    VersionedGraph::VersionedGraph(const std::shared_ptr<Graph>& graph) :
+        latest(std::make_shared<const Version>(Version{ 0, std::make_shared<Graph>(graph) })) {}
+
+    std::shared_ptr<Graph> VersionedGraph::snapshot() const {
+        std::uint64_t version {};
+        return this->snapshot(version);
+    }
+
+    std::shared_ptr<Graph> VersionedGraph::snapshot(std::uint64_t& version) const {
+        // the version stays alive while it is copied, even if a writer publishes a new one meanwhile
+        auto pinned = this->latest.load();
+        version = pinned->number;
+        return std::make_shared<Graph>(pinned->graph);
+    }
+
+    std::uint64_t VersionedGraph::getVersion() const {
+        return this->latest.load()->number;
+    }
+
+    std::uint64_t VersionedGraph::update(const std::function<void(Graph&)>& changes) {
+        std::lock_guard<std::mutex> lock(this->writer);
+
+        // only the writers replace the latest version, it does not change until it is replaced below
+        auto current = this->latest.load();
+
+        // the new version shares the lists of the latest one until the changes copy them
+        auto graph = std::make_shared<Graph>(current->graph);
+        changes(*graph);
+
+        std::uint64_t number { current->number + 1 };
+        this->latest.store(std::make_shared<const Version>(Version{ number, graph }));
+
+        // the previous version is released by the last of its users (current here or a snapshot)
+        return number;
+    }
+
+    std::uint64_t VersionedGraph::setEdgeCapacity(int source, int sink, int capacity) {
+        return this->update([source, sink, capacity](Graph& graph) {
+            graph.setEdgeCapacity(source, sink, capacity);
+        });
+    }
+}
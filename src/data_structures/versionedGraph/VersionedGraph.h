@@ -0,0 +1,112 @@
+#ifndef NETWORK_FLOWS_VERSIONEDGRAPH_H
+#define NETWORK_FLOWS_VERSIONEDGRAPH_H
+
+#include "data_structures/graph/Graph.h"
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <functional>
+
+namespace data_structures {
+    /**
+     * Graph shared by a writer applying updates and readers solving on it concurrently (multi-version snapshots).
+     * The published versions are immutable: a writer applies its changes to a copy of the latest version
+     * and publishes the copy as a new version, a reader takes a snapshot of the latest version and keeps it
+     * for the whole solve, while the writer goes on publishing new versions.
+     * The copies are copy-on-write (see Graph), so a version shares with the previous one all the adjacent lists
+     * it does not change: a version costs the copy of the table of the blocks of the lists, of the blocks
+     * and of the lists it changes.
+     * The readers never take a lock: the latest version is published through an atomic shared pointer,
+     * a writer builds its version before storing the pointer and a snapshot only loads it.
+     * The writers are serialized among themselves.
+     * A version is freed when it is not the latest one and no snapshot uses its lists.
+     *
+     * (see: https://en.wikipedia.org/wiki/Multiversion_concurrency_control)
+     */
+    class VersionedGraph {
+        public:
+            /**
+             * Constructor, the graph is the first version (number 0).
+             * The graph is copied (copy-on-write), so the caller can keep modifying it.
+             *
+             * @param graph the graph
+             */
+            explicit VersionedGraph(const std::shared_ptr<Graph>& graph);
+
+            /**
+             * Take a snapshot of the latest version, to solve on it.
+             * The snapshot is a private copy (copy-on-write): the new versions do not change it
+             * and the reader can modify it without changing the versions.
+             *
+             * Time complexity: O(1)
+             *
+             * @return the graph of the latest version
+             */
+            [[nodiscard]] std::shared_ptr<Graph> snapshot() const;
+
+            /**
+             * Take a snapshot of the latest version, with its number.
+             *
+             * Time complexity: O(1)
+             *
+             * @param version the number of the version of the snapshot (output)
+             *
+             * @return the graph of the latest version
+             */
+            [[nodiscard]] std::shared_ptr<Graph> snapshot(std::uint64_t& version) const;
+
+            /**
+             * Get the number of the latest version.
+             *
+             * @return the number of the latest version (0 for the first one, increased by each update)
+             */
+            [[nodiscard]] std::uint64_t getVersion() const;
+
+            /**
+             * Apply changes to a copy of the latest version and publish it as a new version.
+             * If the changes throw, no version is published and the exception is propagated.
+             *
+             * V: number of nodes
+             * Time complexity: O(V / Graph block size) plus the changes and the copy of the blocks and the lists they change
+             *
+             * @param changes the function applying the changes to the new version
+             *
+             * @return the number of the new version
+             */
+            std::uint64_t update(const std::function<void(Graph&)>& changes);
+
+            /**
+             * Set the capacity of the edge source -> sink in a new version (see Graph::setEdgeCapacity()).
+             *
+             * @param source   the source node
+             * @param sink     the sink node
+             * @param capacity the new capacity
+             *
+             * @return the number of the new version
+             *
+             * @throws invalid_argument if the nodes do not exist
+             * @throws invalid_argument if the edge does not exist
+             * @throws invalid_argument if the capacity is negative
+             */
+            std::uint64_t setEdgeCapacity(int source, int sink, int capacity);
+
+        private:
+            /**
+             * Published version, never modified.
+             */
+            struct Version {
+                std::uint64_t number;
+                std::shared_ptr<Graph> graph;
+            };
+
+            // latest version (replaced by the writers, the version is never modified)
+            std::atomic<std::shared_ptr<const Version>> latest;
+
+            // serializes the writers
+            std::mutex writer;
+    };
+}
+
+#endif //NETWORK_FLOWS_VERSIONEDGRAPH_H
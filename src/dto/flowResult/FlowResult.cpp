@@ -4,8 +4,21 @@
 
 namespace dto {
     FlowResult::FlowResult(std::shared_ptr<data_structures::Graph> graph, int flow) :
+        FlowResult(std::move(graph), flow, std::make_shared<std::vector<int>>()) {}
+
+    FlowResult::FlowResult(std::shared_ptr<data_structures::Graph> graph, int flow, std::shared_ptr<std::vector<int>> edge_flow) :
+        flow(flow),
+        graph(std::move(graph)),
+        edge_flow(std::move(edge_flow)),
+        potential(std::make_shared<std::vector<int>>()) {}
+
+    FlowResult::FlowResult(std::shared_ptr<data_structures::Graph> graph, int flow, std::shared_ptr<std::vector<int>> edge_flow,
+        std::shared_ptr<std::vector<int>> potential, std::shared_ptr<data_structures::Graph> reduced_cost_graph) :
         flow(flow),
-        graph(std::move(graph)) {}
+        graph(std::move(graph)),
+        edge_flow(std::move(edge_flow)),
+        potential(std::move(potential)),
+        reduced_cost_graph(std::move(reduced_cost_graph)) {}
 
     std::shared_ptr<data_structures::Graph> FlowResult::getGraph() const {
         return this->graph;
@@ -14,4 +27,16 @@ namespace dto {
     int FlowResult::getFlow() const {
         return this->flow;
     }
-}
\ No newline at end of file
+
+    std::shared_ptr<std::vector<int>> FlowResult::getEdgeFlow() const {
+        return this->edge_flow;
+    }
+
+    std::shared_ptr<std::vector<int>> FlowResult::getPotential() const {
+        return this->potential;
+    }
+
+    std::shared_ptr<data_structures::Graph> FlowResult::getReducedCostGraph() const {
+        return this->reduced_cost_graph;
+    }
+}
@@ -7,6 +7,9 @@ namespace dto {
     /**
      * Class that represents the result of the flow's algorithms.
      * It contains the graph and the flow.
+     * The minimum cost flow algorithms also return the flow of each edge as a flat array indexed by edge id.
+     * The minimum cost flow algorithms based on node potentials also return the potentials (dual values)
+     * and the graph with the reduced cost of each edge, which certify the optimality of the flow.
      */
     class FlowResult {
     public:
@@ -18,6 +21,27 @@ namespace dto {
          */
         FlowResult(std::shared_ptr<data_structures::Graph> graph, int flow);
 
+        /**
+         * Constructor with the flow of each edge.
+         *
+         * @param graph     the graph
+         * @param flow      the flow
+         * @param edge_flow the flow of each edge id
+         */
+        FlowResult(std::shared_ptr<data_structures::Graph> graph, int flow, std::shared_ptr<std::vector<int>> edge_flow);
+
+        /**
+         * Constructor with the optimality certificate.
+         *
+         * @param graph              the graph
+         * @param flow               the flow
+         * @param edge_flow          the flow of each edge id
+         * @param potential          the potential of each node
+         * @param reduced_cost_graph the graph with the flow as capacity and the reduced cost as cost of each edge
+         */
+        FlowResult(std::shared_ptr<data_structures::Graph> graph, int flow, std::shared_ptr<std::vector<int>> edge_flow,
+            std::shared_ptr<std::vector<int>> potential, std::shared_ptr<data_structures::Graph> reduced_cost_graph);
+
         /**
          * Getter for the graph.
          *
@@ -32,9 +56,41 @@ namespace dto {
          */
         [[nodiscard]] int getFlow() const;
 
+        /**
+         * Getter for the flow of each edge.
+         * The flow of the edge with id i is at position i, so parallel edges are reported separately.
+         * The flow of an undirected edge is negative if it goes from its sink to its source.
+         * If the algorithm does not compute it (e.g. the maximum flow algorithms, whose graph is the residual graph),
+         * returns an empty vector (see GraphUtils::GetEdgeFlow()).
+         *
+         * @return the flow of each edge id
+         */
+        [[nodiscard]] std::shared_ptr<std::vector<int>> getEdgeFlow() const;
+
+        /**
+         * Getter for the node potentials (dual values).
+         * The reduced cost of the edge u -> v is cost - potential[u] + potential[v]: it is non-negative
+         * for the edges not saturated and non-positive for the edges with flow.
+         * If the algorithm does not compute the potentials, returns an empty vector.
+         *
+         * @return the potential of each node
+         */
+        [[nodiscard]] std::shared_ptr<std::vector<int>> getPotential() const;
+
+        /**
+         * Getter for the reduced costs.
+         * If the algorithm does not compute the potentials, returns nullptr.
+         *
+         * @return the graph with the flow as capacity and the reduced cost as cost of each edge
+         */
+        [[nodiscard]] std::shared_ptr<data_structures::Graph> getReducedCostGraph() const;
+
     private:
         int flow;
         std::shared_ptr<data_structures::Graph> graph;
+        std::shared_ptr<std::vector<int>> edge_flow;
+        std::shared_ptr<std::vector<int>> potential;
+        std::shared_ptr<data_structures::Graph> reduced_cost_graph;
     };
 }
 
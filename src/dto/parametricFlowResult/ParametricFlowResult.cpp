@@ -0,0 +1,38 @@
+#include "ParametricFlowResult.h"
+
+#include <utility>
+
+namespace dto {
+    ParametricFlowResult::ParametricFlowResult(std::shared_ptr<std::vector<double>> breakpoints, std::shared_ptr<std::vector<long long>> intercepts,
+        std::shared_ptr<std::vector<long long>> slopes, std::shared_ptr<std::vector<std::shared_ptr<std::vector<int>>>> cuts) :
+        breakpoints(std::move(breakpoints)),
+        intercepts(std::move(intercepts)),
+        slopes(std::move(slopes)),
+        cuts(std::move(cuts)) {}
+
+    std::shared_ptr<std::vector<double>> ParametricFlowResult::getBreakpoints() const {
+        return this->breakpoints;
+    }
+
+    std::shared_ptr<std::vector<long long>> ParametricFlowResult::getIntercepts() const {
+        return this->intercepts;
+    }
+
+    std::shared_ptr<std::vector<long long>> ParametricFlowResult::getSlopes() const {
+        return this->slopes;
+    }
+
+    std::shared_ptr<std::vector<std::shared_ptr<std::vector<int>>>> ParametricFlowResult::getCuts() const {
+        return this->cuts;
+    }
+
+    double ParametricFlowResult::getFlow(double lambda) const {
+        // find the segment containing lambda
+        unsigned segment { 0 };
+        while (segment < this->breakpoints->size() && lambda > this->breakpoints->at(segment)) {
+            segment++;
+        }
+
+        return this->intercepts->at(segment) + lambda * this->slopes->at(segment);
+    }
+}
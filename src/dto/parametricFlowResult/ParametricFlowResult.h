@@ -0,0 +1,74 @@
+#ifndef NETWORK_FLOWS_PARAMETRICFLOWRESULT_H
+#define NETWORK_FLOWS_PARAMETRICFLOWRESULT_H
+
+#include <vector>
+#include <memory>
+
+namespace dto {
+    /**
+     * Class that represents the result of the parametric maximum flow algorithm.
+     * The maximum flow as a function of the parameter λ is piecewise linear: between two consecutive
+     * breakpoints it is equal to intercept + λ * slope, where intercept and slope are the capacities of
+     * the fixed and of the parametric edges of the minimum cut of the segment.
+     * The segment i goes from breakpoint i - 1 to breakpoint i (the first starts at the minimum λ,
+     * the last ends at the maximum λ), so there is one segment more than the breakpoints.
+     */
+    class ParametricFlowResult {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param breakpoints the values of λ where the slope of the maximum flow changes
+         * @param intercepts  the intercept of each segment
+         * @param slopes      the slope of each segment
+         * @param cuts        the source side of the minimum cut of each segment
+         */
+        ParametricFlowResult(std::shared_ptr<std::vector<double>> breakpoints, std::shared_ptr<std::vector<long long>> intercepts,
+            std::shared_ptr<std::vector<long long>> slopes, std::shared_ptr<std::vector<std::shared_ptr<std::vector<int>>>> cuts);
+
+        /**
+         * Getter for the breakpoints.
+         *
+         * @return the values of λ where the slope of the maximum flow changes, in increasing order
+         */
+        [[nodiscard]] std::shared_ptr<std::vector<double>> getBreakpoints() const;
+
+        /**
+         * Getter for the intercepts.
+         *
+         * @return the intercept of each segment
+         */
+        [[nodiscard]] std::shared_ptr<std::vector<long long>> getIntercepts() const;
+
+        /**
+         * Getter for the slopes.
+         *
+         * @return the slope of each segment
+         */
+        [[nodiscard]] std::shared_ptr<std::vector<long long>> getSlopes() const;
+
+        /**
+         * Getter for the minimum cuts.
+         *
+         * @return the source side of the minimum cut of each segment (the cuts are nested)
+         */
+        [[nodiscard]] std::shared_ptr<std::vector<std::shared_ptr<std::vector<int>>>> getCuts() const;
+
+        /**
+         * Get the maximum flow for the given value of the parameter.
+         *
+         * @param lambda the value of the parameter
+         *
+         * @return the maximum flow
+         */
+        [[nodiscard]] double getFlow(double lambda) const;
+
+    private:
+        std::shared_ptr<std::vector<double>> breakpoints;
+        std::shared_ptr<std::vector<long long>> intercepts;
+        std::shared_ptr<std::vector<long long>> slopes;
+        std::shared_ptr<std::vector<std::shared_ptr<std::vector<int>>>> cuts;
+    };
+}
+
+#endif //NETWORK_FLOWS_PARAMETRICFLOWRESULT_H
@@ -0,0 +1,45 @@
+#include "EdgeSensitivity.h"
+
+namespace dto {
+    EdgeSensitivity::EdgeSensitivity(int id, int source, int sink, int flow, int cost, int reduced_cost, int min_cost, int max_cost) :
+        id(id),
+        source(source),
+        sink(sink),
+        flow(flow),
+        cost(cost),
+        reduced_cost(reduced_cost),
+        min_cost(min_cost),
+        max_cost(max_cost) {}
+
+    int EdgeSensitivity::getId() const {
+        return this->id;
+    }
+
+    int EdgeSensitivity::getSource() const {
+        return this->source;
+    }
+
+    int EdgeSensitivity::getSink() const {
+        return this->sink;
+    }
+
+    int EdgeSensitivity::getFlow() const {
+        return this->flow;
+    }
+
+    int EdgeSensitivity::getCost() const {
+        return this->cost;
+    }
+
+    int EdgeSensitivity::getReducedCost() const {
+        return this->reduced_cost;
+    }
+
+    int EdgeSensitivity::getMinCost() const {
+        return this->min_cost;
+    }
+
+    int EdgeSensitivity::getMaxCost() const {
+        return this->max_cost;
+    }
+}
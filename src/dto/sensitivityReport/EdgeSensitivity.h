@@ -0,0 +1,95 @@
+#ifndef NETWORK_FLOWS_EDGESENSITIVITY_H
+#define NETWORK_FLOWS_EDGESENSITIVITY_H
+
+namespace dto {
+    /**
+     * Class that represents the sensitivity of the optimal flow to the cost of a single edge.
+     * The optimal flow stays optimal as long as the cost of the edge (with all the other costs unchanged)
+     * is inside the range [min cost, max cost].
+     * An unbounded side of the range is std::numeric_limits<int>::min() or std::numeric_limits<int>::max().
+     */
+    class EdgeSensitivity {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param id           the id of the edge
+         * @param source       the source of the edge
+         * @param sink         the sink of the edge
+         * @param flow         the optimal flow of the edge
+         * @param cost         the cost of the edge
+         * @param reduced_cost the reduced cost of the edge
+         * @param min_cost     the minimum cost for which the flow stays optimal
+         * @param max_cost     the maximum cost for which the flow stays optimal
+         */
+        EdgeSensitivity(int id, int source, int sink, int flow, int cost, int reduced_cost, int min_cost, int max_cost);
+
+        /**
+         * Get the id of the edge (parallel edges have different ids).
+         *
+         * @return the id of the edge
+         */
+        [[nodiscard]] int getId() const;
+
+        /**
+         * Get the source of the edge.
+         *
+         * @return the source of the edge
+         */
+        [[nodiscard]] int getSource() const;
+
+        /**
+         * Get the sink of the edge.
+         *
+         * @return the sink of the edge
+         */
+        [[nodiscard]] int getSink() const;
+
+        /**
+         * Get the optimal flow of the edge.
+         *
+         * @return the optimal flow of the edge
+         */
+        [[nodiscard]] int getFlow() const;
+
+        /**
+         * Get the cost of the edge.
+         *
+         * @return the cost of the edge
+         */
+        [[nodiscard]] int getCost() const;
+
+        /**
+         * Get the reduced cost of the edge.
+         *
+         * @return the reduced cost of the edge
+         */
+        [[nodiscard]] int getReducedCost() const;
+
+        /**
+         * Get the minimum cost for which the flow stays optimal.
+         *
+         * @return the minimum cost (std::numeric_limits<int>::min() if unbounded)
+         */
+        [[nodiscard]] int getMinCost() const;
+
+        /**
+         * Get the maximum cost for which the flow stays optimal.
+         *
+         * @return the maximum cost (std::numeric_limits<int>::max() if unbounded)
+         */
+        [[nodiscard]] int getMaxCost() const;
+
+    private:
+        int id;
+        int source;
+        int sink;
+        int flow;
+        int cost;
+        int reduced_cost;
+        int min_cost;
+        int max_cost;
+    };
+}
+
+#endif //NETWORK_FLOWS_EDGESENSITIVITY_H
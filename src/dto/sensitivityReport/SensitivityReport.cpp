@@ -0,0 +1,45 @@
+#include "SensitivityReport.h"
+
+#include "utils/json.hpp"
+
+#include <limits>
+#include <utility>
+
+using json = nlohmann::ordered_json;
+
+namespace dto {
+    SensitivityReport::SensitivityReport(std::shared_ptr<std::vector<int>> potential, std::shared_ptr<std::vector<EdgeSensitivity>> edges) :
+        potential(std::move(potential)),
+        edges(std::move(edges)) {}
+
+    std::shared_ptr<std::vector<int>> SensitivityReport::getPotential() const {
+        return this->potential;
+    }
+
+    std::shared_ptr<std::vector<EdgeSensitivity>> SensitivityReport::getEdges() const {
+        return this->edges;
+    }
+
+    std::string SensitivityReport::toString() const {
+        json report;
+        report["Potentials"] = *this->potential;
+        report["Edges"] = json::array();
+
+        for (auto& e : *this->edges) {
+            json edge;
+            edge["Id"] = e.getId();
+            edge["Source"] = e.getSource();
+            edge["Sink"] = e.getSink();
+            edge["Flow"] = e.getFlow();
+            edge["Cost"] = e.getCost();
+            edge["Reduced_cost"] = e.getReducedCost();
+
+            // unbounded sides of the range are null
+            edge["Min_cost"] = e.getMinCost() == std::numeric_limits<int>::min() ? json() : json(e.getMinCost());
+            edge["Max_cost"] = e.getMaxCost() == std::numeric_limits<int>::max() ? json() : json(e.getMaxCost());
+            report["Edges"].push_back(edge);
+        }
+
+        return report.dump(4);
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef NETWORK_FLOWS_SENSITIVITYREPORT_H
+#define NETWORK_FLOWS_SENSITIVITYREPORT_H
+
+#include "dto/sensitivityReport/EdgeSensitivity.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace dto {
+    /**
+     * Class that represents the sensitivity report of an optimal minimum cost flow.
+     * It contains the node potentials and, for each edge, its reduced cost and the range
+     * of costs for which the flow stays optimal (see EdgeSensitivity.h).
+     */
+    class SensitivityReport {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param potential the potential of each node
+         * @param edges     the sensitivity of each edge
+         */
+        SensitivityReport(std::shared_ptr<std::vector<int>> potential, std::shared_ptr<std::vector<EdgeSensitivity>> edges);
+
+        /**
+         * Returns the potential of each node.
+         *
+         * @return the potential of each node
+         */
+        [[nodiscard]] std::shared_ptr<std::vector<int>> getPotential() const;
+
+        /**
+         * Returns the sensitivity of each edge.
+         *
+         * @return the sensitivity of each edge
+         */
+        [[nodiscard]] std::shared_ptr<std::vector<EdgeSensitivity>> getEdges() const;
+
+        /**
+         * Print the report in JSON format.
+         */
+        [[nodiscard]] std::string toString() const;
+
+    private:
+        std::shared_ptr<std::vector<int>> potential;
+        std::shared_ptr<std::vector<EdgeSensitivity>> edges;
+    };
+}
+
+#endif //NETWORK_FLOWS_SENSITIVITYREPORT_H
@@ -0,0 +1,20 @@
+#include "SolveProgress.h"
+
+namespace dto {
+    SolveProgress::SolveProgress(int augmentations, int flow, int cost) :
+        augmentations(augmentations),
+        flow(flow),
+        cost(cost) {}
+
+    int SolveProgress::getAugmentations() const {
+        return this->augmentations;
+    }
+
+    int SolveProgress::getFlow() const {
+        return this->flow;
+    }
+
+    int SolveProgress::getCost() const {
+        return this->cost;
+    }
+}
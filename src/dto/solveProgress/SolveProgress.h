@@ -0,0 +1,48 @@
+#ifndef NETWORK_FLOWS_SOLVEPROGRESS_H
+#define NETWORK_FLOWS_SOLVEPROGRESS_H
+
+namespace dto {
+    /**
+     * Class that represents the progress of a solve, reported after each augmentation (see utils::ProgressReporter).
+     * It contains the number of augmentations so far, the flow and the cost they sent (the lower bounds excluded).
+     */
+    class SolveProgress {
+        public:
+            /**
+             * Construct a new Solve Progress object
+             *
+             * @param augmentations the number of augmentations so far
+             * @param flow          the flow sent so far
+             * @param cost          the cost of the flow sent so far
+             */
+            SolveProgress(int augmentations, int flow, int cost);
+
+            /**
+             * Returns the number of augmentations so far
+             *
+             * @return the number of augmentations
+             */
+            [[nodiscard]] int getAugmentations() const;
+
+            /**
+             * Returns the flow sent so far
+             *
+             * @return the flow
+             */
+            [[nodiscard]] int getFlow() const;
+
+            /**
+             * Returns the cost of the flow sent so far (0 for the maximum flow algorithms, which do not use the costs)
+             *
+             * @return the cost
+             */
+            [[nodiscard]] int getCost() const;
+
+    private:
+            int augmentations;
+            int flow;
+            int cost;
+    };
+}
+
+#endif //NETWORK_FLOWS_SOLVEPROGRESS_H
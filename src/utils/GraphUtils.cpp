@@ -4,6 +4,9 @@
 #include "consts/Consts.h"
 #include "data_structures/graph/Edge.h"
 
+#include <map>
+#include <queue>
+#include <limits>
 #include <string>
 #include <memory>
 #include <fstream>
@@ -14,6 +17,10 @@ using json = nlohmann::ordered_json;
 
 namespace utils {
     std::shared_ptr<data_structures::Graph> GraphUtils::CreateGraphFromJSON(const std::string& filename) {
+        return GraphUtils::CreateGraphFromJSON(filename, std::pmr::get_default_resource());
+    }
+
+    std::shared_ptr<data_structures::Graph> GraphUtils::CreateGraphFromJSON(const std::string& filename, std::pmr::memory_resource* resource) {
         // open the file
         std::ifstream infile { filename };
 
@@ -32,16 +39,54 @@ namespace utils {
 
                 // create edges
                 nlohmann::json edges = data.at("Edges");
-                auto graph = std::make_shared<data_structures::Graph>(num_nodes);
+                // parallel edges are allowed, each edge is identified by its id (position in "Edges")
+                auto graph = std::make_shared<data_structures::Graph>(num_nodes, true, resource);
 
                 for (auto& e : edges) {
                     int source { e.at("Source") };
                     int sink { e.at("Sink") };
-                    int capacity { e.at("Capacity") };
-                    int cost { e.at("Cost") };
+
+                    // the nodes are validated here, the solvers access the graph without checks
+                    if (source >= num_nodes || sink >= num_nodes) {
+                        throw std::invalid_argument("edge " + std::to_string(source) + " -> " + std::to_string(sink)
+                            + " has a node greater than Num_nodes - 1");
+                    }
+
+                    // the cost segments are optional, if present the capacity is the total width of the segments
+                    std::shared_ptr<std::vector<std::pair<int, int>>> cost_segments;
+                    int capacity {};
+                    int cost {};
+                    if (e.contains("Cost_segments")) {
+                        cost_segments = std::make_shared<std::vector<std::pair<int, int>>>();
+                        for (auto& segment : e.at("Cost_segments")) {
+                            cost_segments->emplace_back(segment.at("Capacity"), segment.at("Cost"));
+                            capacity += cost_segments->back().first;
+                        }
+                        if (cost_segments->empty()) {
+                            throw std::invalid_argument("cost segments of edge " + std::to_string(source) + " -> "
+                                + std::to_string(sink) + " are empty");
+                        }
+                        cost = cost_segments->front().second;
+                    } else {
+                        capacity = e.at("Capacity");
+                        cost = e.at("Cost");
+                    }
+
+                    // the lower bound and the direction are optional
+                    int lower_bound { e.contains("Lower_bound") ? e.at("Lower_bound").get<int>() : 0 };
+                    bool undirected { e.contains("Undirected") && e.at("Undirected").get<bool>() };
 
                     // add edge to graph
-                    graph->addEdge(source, sink, capacity, cost);
+                    data_structures::Edge edge(source, sink, capacity, cost, lower_bound);
+                    edge.setUndirected(undirected);
+                    graph->addEdge(edge, cost_segments);
+                }
+
+                // the node capacities are optional
+                if (data.contains("Node_capacities")) {
+                    for (auto& n : data.at("Node_capacities")) {
+                        graph->setNodeCapacity(n.at("Node"), n.at("Capacity"));
+                    }
                 }
                 return graph;
                 
@@ -55,29 +100,58 @@ namespace utils {
     }
 
     std::shared_ptr<data_structures::Graph> GraphUtils::GetResidualGraph(const std::shared_ptr<data_structures::Graph>& graph) {
-        auto residual_graph = std::make_shared<data_structures::Graph>(graph->getNumNodes());
+        auto residual_graph = std::make_shared<data_structures::Graph>(graph->getNumNodes(), false, graph->getMemoryResource());
 
         for (int source = 0; source < graph->getNumNodes(); source++) {
             for (auto e : *graph->getNodeAdjList(source)) {
                 int sink { e.getSink() };
-                int capacity { e.getCapacity() };
                 int cost { e.getCost() };
 
+                // the lower bound is considered as already sent (see GetLowerBoundsImbalance)
+                int capacity { e.getCapacity() - e.getLowerBound() };
+
                 // the residual graph contains only the edges with positive capacity
                 if (capacity <= 0) {
                     continue;
                 }
 
+                // an undirected edge is a single pair of residual edges sharing the capacity
+                // (u -> v has capacity - flow, v -> u has capacity + flow), it is added directly
+                // only if there are no other edges between source and sink
+                if (e.isUndirected()) {
+                    auto adj_list = graph->getNodeAdjList(source);
+                    auto reverse_adj_list = graph->getNodeAdjList(sink);
+                    auto to_sink = [sink](const data_structures::Edge& edge) { return edge.getSink() == sink; };
+                    auto to_source = [source](const data_structures::Edge& edge) { return edge.getSink() == source; };
+                    bool single_edge { std::count_if(adj_list->begin(), adj_list->end(), to_sink) == 1
+                        && std::none_of(reverse_adj_list->begin(), reverse_adj_list->end(), to_source) };
+
+                    if (single_edge) {
+                        residual_graph->addEdge(source, sink, capacity, cost);
+                        residual_graph->addEdge(sink, source, capacity, cost);
+                    } else {
+                        int artificial_node { residual_graph->getNumNodes() };
+                        residual_graph->addEdge(source, artificial_node, capacity, cost);
+                        residual_graph->addEdge(artificial_node, source, capacity, 0);
+                        residual_graph->addEdge(artificial_node, sink, capacity, 0);
+                        residual_graph->addEdge(sink, artificial_node, capacity, cost);
+                        residual_graph->addArtificialNodes(artificial_node, e);
+                    }
+                    continue;
+                }
+
                 // handle anti-parallel edges adding an artificial node between source and sink.
                 // the value of the artificial node is the value of source node plus the number of nodes,
                 // it will be easy to retrieve the original source node from the artificial node doing a simple subtraction
 
-                // check if the edge is anti-parallel, and it is not already in the residual graph (source < sink)
-                if (source < sink && graph->hasEdge(sink, source)) {
+                // check if the edge is anti-parallel, and it is not already in the residual graph (source < sink),
+                // or if it is parallel to an edge already in the residual graph (multigraph)
+                if ((source < sink && graph->hasEdge(sink, source)) || residual_graph->hasEdge(source, sink)) {
                     // add the artificial node
                     int artificial_node { residual_graph->getNumNodes() };
+                    // the cost is paid only once, on the first half of the edge
                     residual_graph->addEdge(source, artificial_node, capacity, cost);
-                    residual_graph->addEdge(artificial_node, sink, capacity, cost);
+                    residual_graph->addEdge(artificial_node, sink, capacity, 0);
                     residual_graph->addArtificialNodes(artificial_node, e);
                 } else {
                     // else simply add the edge to the residual graph
@@ -86,62 +160,295 @@ namespace utils {
             }
         }
 
+        // the residual capacity of a node is its capacity minus the flow already entering it (the lower bounds)
+        if (!graph->getNodeCapacities()->empty()) {
+            std::vector<int> lower_bounds_inflow(graph->getNumNodes(), 0);
+            for (int source = 0; source < graph->getNumNodes(); source++) {
+                for (auto e : *graph->getNodeAdjList(source)) {
+                    lower_bounds_inflow.at(e.getSink()) += e.getLowerBound();
+                }
+            }
+            for (auto& [node, capacity] : *graph->getNodeCapacities()) {
+                residual_graph->setNodeCapacity(node, std::max(capacity - lower_bounds_inflow.at(node), 0));
+            }
+        }
+
         return residual_graph;
     }
 
     std::shared_ptr<data_structures::Graph> GraphUtils::GetOptimalGraph(const std::shared_ptr<data_structures::Graph>& residual_graph,
         const std::shared_ptr<data_structures::Graph>& graph) {
 
-        auto optimal_graph = std::make_shared<data_structures::Graph>(residual_graph->getStartingNumNodes());
-        auto artificial_nodes = residual_graph->getArtificialNodesMap();
+        auto optimal_graph = std::make_shared<data_structures::Graph>(graph->getNumNodes(), graph->isMultigraph(), graph->getMemoryResource());
+
+        // artificial node of each split edge (by edge id)
+        std::map<int, int> split_edges;
+        for (auto& it : *residual_graph->getArtificialNodesMap()) {
+            split_edges.insert({ it.second.getId(), it.first });
+        }
 
         for (int source = 0; source < graph->getNumNodes(); source++) {
-            for (auto e : *residual_graph->getNodeAdjList(source)) {
-                
+            for (auto e : *graph->getNodeAdjList(source)) {
                 int sink { e.getSink() };
-                
-                // discard the edges present in the original graph
-                // since they contain the remaining capacity of the edge.
-                if (graph->hasEdge(source, sink)) {
+                int capacity { e.getCapacity() - e.getLowerBound() };
+
+                // the flow is the capacity minus the remaining capacity of the edge in the residual graph
+                // (the edge of the residual graph is removed when it is saturated).
+                // If the edge was split, the remaining capacity is on the first half of the edge
+                int flow {};
+                if (capacity > 0) {
+                    auto split_edge = split_edges.find(e.getId());
+                    int residual_sink { split_edge != split_edges.end() ? split_edge->second : sink };
+                    int remaining_capacity { residual_graph->hasEdge(source, residual_sink)
+                        ? residual_graph->getEdgeUnchecked(source, residual_sink).getCapacity() : 0 };
+                    flow = capacity - remaining_capacity;
+                }
+
+                // the flow of an undirected edge can go from sink to source (negative flow),
+                // in the optimal graph the edge follows the direction of the flow
+                if (flow < 0) {
+                    data_structures::Edge reverse_edge(sink, source, -flow, e.getCost());
+                    reverse_edge.setId(e.getId());
+                    reverse_edge.setUndirected(true);
+                    optimal_graph->addEdge(reverse_edge);
                     continue;
                 }
 
-                int capacity { e.getCapacity() };
+                // add the edge to the optimal graph (same id), the lower bound was already sent
+                e.setCapacity(flow + e.getLowerBound());
+                e.setLowerBound(0);
+                optimal_graph->addEdge(e, graph->getCostSegments(e.getId()));
+            }
+        }
 
-                // remove the artificial node added to handle anti-parallel edges
-                if (sink >= graph->getNumNodes()) {
-                    // get the original source node by getting the sink of
-                    // the only edge of the artificial node not the opposite of the current edge
-                    auto original_edge = artificial_nodes->find(sink)->second;
+        return optimal_graph;
+    }
 
-                    // since we are looking for the backward edge,
-                    // if the source is the original one, continue
-                    if (original_edge.getSource() == source) {
-                        continue;
-                    }
+    std::shared_ptr<std::vector<int>> GraphUtils::GetMinCut(const std::shared_ptr<data_structures::Graph>& residual_graph, int source) {
+        std::vector<bool> visited(residual_graph->getNumNodes(), false);
+        visited.at(source) = true;
+
+        // visit the nodes reachable from the source, every edge of the residual graph has positive capacity
+        std::queue<int> q {};
+        q.push(source);
+        while (!q.empty()) {
+            int node { q.front() };
+            q.pop();
+
+            for (auto e : *residual_graph->getNodeAdjList(node)) {
+                if (!visited.at(e.getSink())) {
+                    visited.at(e.getSink()) = true;
+                    q.push(e.getSink());
+                }
+            }
+        }
 
-                    original_edge.setCapacity(capacity);
-                    optimal_graph->addEdge(original_edge);
-                } else {
-                    int start_cost { graph->getEdge(sink, source).getCost() };
+        // keep only the nodes of the starting graph
+        auto cut = std::make_shared<std::vector<int>>();
+        for (int node = 0; node < residual_graph->getStartingNumNodes(); node++) {
+            if (visited.at(node)) {
+                cut->push_back(node);
+            }
+        }
 
-                    // add the edge to the optimal graph
-                    optimal_graph->addEdge(sink, source, capacity, start_cost);
+        return cut;
+    }
+
+    std::shared_ptr<std::vector<int>> GraphUtils::GetLowerBoundsImbalance(const std::shared_ptr<data_structures::Graph>& graph) {
+        auto imbalance = std::make_shared<std::vector<int>>(graph->getNumNodes(), 0);
+
+        for (int source = 0; source < graph->getNumNodes(); source++) {
+            for (auto e : *graph->getNodeAdjList(source)) {
+                // the lower bound leaves the source and enters the sink
+                imbalance->at(source) -= e.getLowerBound();
+                imbalance->at(e.getSink()) += e.getLowerBound();
+            }
+        }
+
+        return imbalance;
+    }
+
+    std::shared_ptr<std::vector<int>> GraphUtils::GetEdgeFlow(const std::shared_ptr<data_structures::Graph>& flow_graph,
+        const std::shared_ptr<data_structures::Graph>& graph) {
+        auto edge_flow = std::make_shared<std::vector<int>>(flow_graph->getNumEdgeIds(), 0);
+
+        // source of each undirected edge of the graph (-1 for the directed edges, they are never reversed)
+        std::vector<int> undirected_source(graph->getNumEdgeIds(), -1);
+        for (int u = 0; u < graph->getNumNodes(); u++) {
+            for (auto& e : *graph->getNodeAdjList(u)) {
+                if (e.isUndirected()) {
+                    undirected_source.at(e.getId()) = u;
                 }
             }
         }
 
-        // add the edges of the original graph that are not in the residual graph
+        for (int u = 0; u < flow_graph->getNumNodes(); u++) {
+            for (auto& e : *flow_graph->getNodeAdjList(u)) {
+                bool reversed { e.getId() < static_cast<int>(undirected_source.size())
+                    && undirected_source.at(e.getId()) != -1 && undirected_source.at(e.getId()) != u };
+                edge_flow->at(e.getId()) = reversed ? -e.getCapacity() : e.getCapacity();
+            }
+        }
+
+        return edge_flow;
+    }
+
+    std::shared_ptr<data_structures::Graph> GraphUtils::GetRenumberedGraph(const std::shared_ptr<data_structures::Graph>& graph,
+        const std::vector<int>& new_node) {
+        int num_nodes { graph->getNumNodes() };
+        if (static_cast<int>(new_node.size()) != num_nodes) {
+            throw std::invalid_argument("The renumbering must have one node for each node of the graph");
+        }
+        std::vector<bool> used(num_nodes, false);
+        for (int v : new_node) {
+            if (v < 0 || v >= num_nodes || used.at(v)) {
+                throw std::invalid_argument("The renumbering must be a permutation of the nodes");
+            }
+            used.at(v) = true;
+        }
+
+        auto renumbered_graph = std::make_shared<data_structures::Graph>(num_nodes, graph->isMultigraph(), graph->getMemoryResource());
+        for (int u = 0; u < num_nodes; u++) {
+            for (auto e : *graph->getNodeAdjList(u)) {
+                data_structures::Edge edge(new_node.at(u), new_node.at(e.getSink()), e.getCapacity(), e.getCost(), e.getLowerBound());
+                edge.setId(e.getId());
+                edge.setUndirected(e.isUndirected());
+                renumbered_graph->addEdge(edge, graph->getCostSegments(e.getId()));
+            }
+        }
+
+        for (auto& [node, capacity] : *graph->getNodeCapacities()) {
+            renumbered_graph->setNodeCapacity(new_node.at(node), capacity);
+        }
+
+        return renumbered_graph;
+    }
+
+    bool GraphUtils::HasUndirectedEdges(const std::shared_ptr<data_structures::Graph>& graph) {
         for (int source = 0; source < graph->getNumNodes(); source++) {
             for (auto e : *graph->getNodeAdjList(source)) {
-                // if the optimal graph does not contain the edge, add it with 0 flow
-                if ( !optimal_graph->hasEdge(source, e.getSink()) ) {
-                    optimal_graph->addEdge(source, e.getSink(), 0, e.getCost());
+                if (e.isUndirected()) {
+                    return true;
                 }
             }
         }
 
-        return optimal_graph;
+        return false;
+    }
+
+    bool GraphUtils::HasConvexCosts(const std::shared_ptr<data_structures::Graph>& graph) {
+        return graph->hasCostSegments();
+    }
+
+    int GraphUtils::DecomposeFlow(const std::shared_ptr<data_structures::Graph>& flow_graph, int source, int sink,
+        const std::function<void(const std::vector<int>& path, int flow)>& consumer) {
+
+        int num_nodes { flow_graph->getNumNodes() };
+
+        // remaining flow of the edges leaving each node: (sink, flow)
+        std::vector<std::vector<std::pair<int, int>>> remaining(num_nodes);
+        std::vector<int> balance(num_nodes, 0); // outgoing flow - incoming flow
+
+        // the virtual edge sink -> source is the first edge of the sink, so the walks reaching the sink
+        // go back to the source and the paths are emitted before the cycles
+        remaining.at(sink).emplace_back(source, 0);
+
+        for (int u = 0; u < num_nodes; u++) {
+            for (auto e : *flow_graph->getNodeAdjList(u)) {
+                if (e.getCapacity() > 0) {
+                    remaining.at(u).emplace_back(e.getSink(), e.getCapacity());
+                    balance.at(u) += e.getCapacity();
+                    balance.at(e.getSink()) -= e.getCapacity();
+                }
+            }
+        }
+
+        for (int u = 0; u < num_nodes; u++) {
+            if (u != source && u != sink && balance.at(u) != 0) {
+                throw std::invalid_argument("The flow is not conserved in node " + std::to_string(u));
+            }
+        }
+        if (balance.at(source) < 0) {
+            throw std::invalid_argument("The flow leaving the source is negative");
+        }
+        remaining.at(sink).front().second = balance.at(source);
+
+        std::vector<unsigned> current(num_nodes, 0); // current edge of each node
+        std::vector<int> position(num_nodes, -1);    // position of each node in the walk, -1 if not in the walk
+        std::vector<int> walk;
+        std::vector<int> path;
+        int count {};
+
+        // start from the source, then from every node with remaining flow
+        for (int k = -1; k < num_nodes; k++) {
+            int start { k == -1 ? source : k };
+
+            walk.assign(1, start);
+            position.at(start) = 0;
+
+            while (!walk.empty()) {
+                int u { walk.back() };
+
+                // move the current edge to the first edge with remaining flow
+                auto& edges = remaining.at(u);
+                while (current.at(u) < edges.size() && edges.at(current.at(u)).second == 0) {
+                    current.at(u)++;
+                }
+
+                if (current.at(u) == edges.size()) {
+                    // by conservation only the start node of a walk can run out of flow
+                    position.at(u) = -1;
+                    walk.pop_back();
+                    continue;
+                }
+
+                int v { edges.at(current.at(u)).first };
+                if (position.at(v) == -1) {
+                    position.at(v) = static_cast<int>(walk.size());
+                    walk.push_back(v);
+                    continue;
+                }
+
+                // cycle found: walk[position[v]] -> ... -> u -> v
+                int first { position.at(v) };
+                int cycle_flow { std::numeric_limits<int>::max() };
+                for (int i = first; i < static_cast<int>(walk.size()); i++) {
+                    int w { walk.at(i) };
+                    cycle_flow = std::min(cycle_flow, remaining.at(w).at(current.at(w)).second);
+                }
+
+                int virtual_position { -1 };
+                for (int i = first; i < static_cast<int>(walk.size()); i++) {
+                    int w { walk.at(i) };
+                    remaining.at(w).at(current.at(w)).second -= cycle_flow;
+                    if (w == sink && current.at(w) == 0) {
+                        virtual_position = i;
+                    }
+                }
+
+                // a cycle through the virtual edge is a source -> sink path
+                path.clear();
+                if (virtual_position != -1) {
+                    int length { static_cast<int>(walk.size()) - first };
+                    for (int i = 1; i <= length; i++) {
+                        path.push_back(walk.at(first + (virtual_position - first + i) % length));
+                    }
+                } else {
+                    path.insert(path.end(), walk.begin() + first, walk.end());
+                    path.push_back(v);
+                }
+                consumer(path, cycle_flow);
+                count++;
+
+                // go back to the start of the cycle
+                for (int i = first + 1; i < static_cast<int>(walk.size()); i++) {
+                    position.at(walk.at(i)) = -1;
+                }
+                walk.resize(first + 1);
+            }
+        }
+
+        return count;
     }
 
     std::shared_ptr<std::vector<int>> GraphUtils::RetrievePath(const std::shared_ptr<std::vector<int>>& parent, int source, int sink) {
@@ -173,12 +480,12 @@ namespace utils {
             return 0;
         }
 
-        // find the minimum capacity in the path
+        // find the minimum capacity in the path (the nodes of a path are nodes of the graph, no checks needed)
         for (unsigned u = 0; u < path->size()-1; u++) {
             int v { static_cast<int>(u + 1) };
-            int source { path->at(u) };
-            int sink { path->at(v) };
-            path_flow = std::min(path_flow, residual_graph->getEdge(source, sink).getCapacity());
+            int source { (*path)[u] };
+            int sink { (*path)[v] };
+            path_flow = std::min(path_flow, residual_graph->getEdgeUnchecked(source, sink).getCapacity());
         }
 
         return path_flow;
@@ -187,22 +494,23 @@ namespace utils {
     void GraphUtils::SendFlowInPathNegativeCosts(const std::shared_ptr<data_structures::Graph>& residual_graph, const std::shared_ptr<std::vector<int>>& path, int flow) {
         for (unsigned u = 0; u < path->size()-1; u++) {
             int v { static_cast<int>(u + 1) };
-            int source { path->at(u) };
-            int sink { path->at(v) };
+            int source { (*path)[u] };
+            int sink { (*path)[v] };
 
-            auto edge = residual_graph->getEdge(source, sink);
+            // the edge is read and updated in place with a single lookup
+            auto& edge = residual_graph->getMutableEdgeUnchecked(source, sink);
             int cost { edge.getCost() };
             
-            int capacity = { residual_graph->getEdge(source, sink).getCapacity() };
+            int capacity = { edge.getCapacity() };
             if (capacity < flow) {
                 throw std::invalid_argument("The flow is greater than the residual capacity of the edge");
             }
             
             capacity -= flow;
             if (!capacity) {
-                residual_graph->removeEdge(source, sink);
+                residual_graph->removeEdgeUnchecked(source, sink);
             } else {
-                residual_graph->setEdgeCapacity(source, sink, capacity);
+                edge.setCapacity(capacity);
             }
 
             // if there is a flow, add the reverse edge
@@ -211,7 +519,8 @@ namespace utils {
                 if (!residual_graph->hasEdge(sink, source)) {
                     residual_graph->addEdge(sink, source, flow, -cost);
                 } else {
-                    residual_graph->setEdgeCapacity(sink, source, residual_graph->getEdge(sink, source).getCapacity() + flow);
+                    auto& reverse_edge = residual_graph->getMutableEdgeUnchecked(sink, source);
+                    reverse_edge.setCapacity(reverse_edge.getCapacity() + flow);
                 }
             } 
         }
@@ -220,11 +529,12 @@ namespace utils {
     void GraphUtils::SendFlowInPathReducedCosts(const std::shared_ptr<data_structures::Graph>& residual_graph, const std::shared_ptr<std::vector<int>>& path, int flow) {
             for (unsigned u = 0; u < path->size()-1; u++) {
                 int v { static_cast<int>(u + 1) };
-                int source { path->at(u) };
-                int sink { path->at(v) };
+                int source { (*path)[u] };
+                int sink { (*path)[v] };
                 
-                // send flow in the path, subtract from the residual capacity
-                int capacity { residual_graph->getEdge(source, sink).getCapacity() };
+                // send flow in the path, subtract from the residual capacity (read and updated with a single lookup)
+                auto& edge = residual_graph->getMutableEdgeUnchecked(source, sink);
+                int capacity { edge.getCapacity() };
                 if (capacity < flow) {
                     throw std::invalid_argument("The flow is greater than the residual capacity of the edge");
                 }
@@ -232,9 +542,9 @@ namespace utils {
                 
                 // if residual capacity is 0, remove the edge
                 if (!capacity) {
-                    residual_graph->removeEdge(source, sink);
+                    residual_graph->removeEdgeUnchecked(source, sink);
                 } else {
-                    residual_graph->setEdgeCapacity(source, sink, capacity);
+                    edge.setCapacity(capacity);
                 }
 
                 // if there is a flow, add the reverse edge
@@ -243,14 +553,15 @@ namespace utils {
                     if (!residual_graph->hasEdge(sink, source)) {
                         residual_graph->addEdge(sink, source, flow, 0);
                     } else {
-                        residual_graph->setEdgeCapacity(sink, source, residual_graph->getEdge(sink, source).getCapacity() + flow);
+                        auto& reverse_edge = residual_graph->getMutableEdgeUnchecked(sink, source);
+                        reverse_edge.setCapacity(reverse_edge.getCapacity() + flow);
                     }
                 }
             }
     }
 
     std::shared_ptr<data_structures::Graph> GraphUtils::GetAdmissibleGraph(const std::shared_ptr<data_structures::Graph>& graph) {
-       auto admissible_graph = std::make_shared<data_structures::Graph>(graph->getNumNodes());
+       auto admissible_graph = std::make_shared<data_structures::Graph>(graph->getNumNodes(), false, graph->getMemoryResource());
 
         for (int source = 0; source < graph->getNumNodes(); source++) {
             for (auto e : *graph->getNodeAdjList(source)) {
@@ -4,6 +4,9 @@
 #include "data_structures/graph/Graph.h"
 
 #include <string>
+#include <vector>
+#include <functional>
+#include <memory_resource>
 
 namespace  utils {
     /**
@@ -21,15 +24,21 @@ namespace  utils {
              *        "Source": -,
              *        "Sink": -,
              *        "Capacity": -,
-             *        "Cost": -
+             *        "Cost": -,
+             *        "Lower_bound": - (optional, 0 by default),
+             *        "Undirected": true/false (optional, false by default, no lower bound and cost segments),
+             *        "Cost_segments": [ { "Capacity": -, "Cost": - }, ... ] (optional, convex piecewise-linear cost,
+             *                          if present "Capacity" and "Cost" of the edge are not needed)
              *       },
              *      ...
-             *   ]
+             *   ],
+             *   "Node_capacities": [ { "Node": -, "Capacity": - }, ... ] (optional, maximum flow through each node)
              * }
              * 
-             * The graph is directed.
+             * The graph is directed and can have parallel edges, the id of each edge is its position in "Edges".
              * All the nodes must be numbered from 0 to Num_nodes - 1 using consecutive numbers.
              * All the values must be positive integer.
+             * The lower bound of an edge cannot be greater than its capacity.
              * 
              * (See data folder to see some examples of json file).
              *
@@ -42,12 +51,34 @@ namespace  utils {
              */
             static std::shared_ptr<data_structures::Graph> CreateGraphFromJSON(const std::string& filename);
 
+            /**
+             * Create graph from json with the given memory resource (see CreateGraphFromJSON(filename) for the format).
+             * The graphs built by the solvers from it use the same resource.
+             *
+             * @param filename name of the file to read
+             * @param resource the memory resource of the graph, it must outlive the graph and the graphs built from it
+             *
+             * @return graph created from the file inputs
+             *
+             * @throws invalid_argument if the file does not exist
+             * @throws invalid_argument if the json is not formatted correctly
+             */
+            static std::shared_ptr<data_structures::Graph> CreateGraphFromJSON(const std::string& filename, std::pmr::memory_resource* resource);
+
             /**
              * Get the residual graph of the given graph.
              * The residual graph is a graph that indicates how much flow can be pushed through the edges.
              * For each edge u -> v, the residual graph has an edge v -> u with capacity equal to the current pushed flow.
              * Residual graph cannot contains anti-parallels edges, they are handled using artificial nodes.
+             * Parallel edges (multigraph) are handled in the same way: only the first one is added directly.
+             * An undirected edge is a single pair u -> v, v -> u with the capacity of the edge in both directions
+             * (sending flow on one of them increases the capacity of the other), split by an artificial node only
+             * if there are other edges between u and v.
+             * The nodes keep their capacities, minus the lower bounds of the edges entering them (see
+             * MaximumFlowAlgorithms::EdmondsKarp() for how they are enforced without splitting the nodes).
              * (Anti-parallel explained: https://www.hackerearth.com/practice/algorithms/graphs/maximum-flow/tutorial/)
+             * The lower bound of each edge is considered as already sent, so the edge u -> v has
+             * capacity - lower bound as residual capacity (see GetLowerBoundsImbalance()).
              * 
              * (see: https://www.hackerearth.com/practice/algorithms/graphs/maximum-flow/tutorial/)
              *
@@ -61,18 +92,123 @@ namespace  utils {
              * Get the optimal graph.
              * It converts te residual graph into the optimal graph.
              * The optimal graph is the graph which contains only the starting edges with the
-             * current flow. 
+             * current flow. The lower bound of each edge is added back to its flow.
+             * Each edge keeps its id, so parallel edges can be told apart (see GetEdgeFlow()).
+             * An undirected edge is reversed if its flow goes from its sink to its source.
              *
              * (see: https://www.hackerearth.com/practice/algorithms/graphs/maximum-flow/tutorial/)
              *
              * @param residual_graph the residual graph from which get the optimal graph
-             * @param graph          the original graph used for add the missing edges
+             * @param graph          the original graph from which the residual graph was built
              * 
              * @return the optimal graph
              */
             static std::shared_ptr<data_structures::Graph> GetOptimalGraph(const std::shared_ptr<data_structures::Graph>& residual_graph,
                 const std::shared_ptr<data_structures::Graph>& graph);
 
+            /**
+             * Get the source side of the minimum cut from the residual graph of a maximum flow.
+             * It contains the nodes reachable from the source in the residual graph
+             * (artificial nodes are not included).
+             *
+             * (see: https://en.wikipedia.org/wiki/Max-flow_min-cut_theorem)
+             *
+             * @param residual_graph the residual graph of a maximum flow
+             * @param source         the source node
+             * 
+             * @return the nodes of the source side of the minimum cut, in increasing order
+             */
+            static std::shared_ptr<std::vector<int>> GetMinCut(const std::shared_ptr<data_structures::Graph>& residual_graph, int source);
+
+            /**
+             * Get the imbalance of each node produced by sending the lower bound of every edge.
+             * Sending l units on the edge u -> v leaves node v with l units of excess and node u
+             * with l units of deficit: the imbalance is the excess (positive) or the deficit (negative).
+             * Together with GetResidualGraph() this is the standard transformation of the lower bounds
+             * into node supplies/demands, without copying the graph.
+             *
+             * @param graph the graph to get the imbalances from
+             * 
+             * @return the imbalance of each node (all zeros if there are no lower bounds)
+             */
+            static std::shared_ptr<std::vector<int>> GetLowerBoundsImbalance(const std::shared_ptr<data_structures::Graph>& graph);
+
+            /**
+             * Get the flow of each edge as a flat array indexed by edge id.
+             * The flow is signed relative to the orientation of the edge in the graph: the flow graph stores
+             * an undirected edge u -> v crossed from v to u as v -> u, its flow is reported as negative.
+             *
+             * @param flow_graph the graph with the flow of each edge as capacity (e.g. the optimal graph)
+             * @param graph      the graph that was solved (same edge ids), it gives the orientation of the edges
+             *
+             * @return the flow of each edge id (0 for the ids of removed edges), negative if it goes from the sink to the source of the edge
+             */
+            static std::shared_ptr<std::vector<int>> GetEdgeFlow(const std::shared_ptr<data_structures::Graph>& flow_graph,
+                                                                 const std::shared_ptr<data_structures::Graph>& graph);
+
+            /**
+             * Get a copy of the graph with the nodes renumbered: the node u becomes new_node->at(u).
+             * The edges keep their ids and attributes, the edges of each node keep their order.
+             * Used with GraphBaseAlgorithms::NodeOrdering() to improve the locality of the solvers.
+             *
+             * @param graph    the graph (without artificial nodes)
+             * @param new_node the new id of each node (a permutation of the nodes)
+             *
+             * @return the renumbered graph
+             *
+             * @throws invalid_argument if new_node is not a permutation of the nodes of the graph
+             */
+            static std::shared_ptr<data_structures::Graph> GetRenumberedGraph(const std::shared_ptr<data_structures::Graph>& graph,
+                const std::vector<int>& new_node);
+
+            /**
+             * Check if the graph has at least one undirected edge (see Edge.h).
+             *
+             * @param graph the graph to check
+             *
+             * @return true if an edge is undirected, false otherwise
+             */
+            static bool HasUndirectedEdges(const std::shared_ptr<data_structures::Graph>& graph);
+
+            /**
+             * Check if the graph has at least one edge with a convex piecewise-linear cost (see Graph::getCostSegments()).
+             *
+             * Time complexity: O(1)
+             *
+             * @param graph the graph to check
+             *
+             * @return true if an edge has cost segments, false otherwise
+             */
+            static bool HasConvexCosts(const std::shared_ptr<data_structures::Graph>& graph);
+
+            /**
+             * Decompose a flow into source -> sink paths and cycles.
+             * The flow is seen as a circulation adding a virtual edge sink -> source with the flow value,
+             * so each cycle through the virtual edge is a source -> sink path (emitted first).
+             * Each walk follows the current edge of each node (the first edge with remaining flow, current-arc pointer):
+             * when it reaches a node already in the walk, the cycle found is emitted with its minimum flow and removed.
+             * Each emitted path/cycle empties at least one edge, so there are at most E + 1 of them, and they are
+             * passed to the consumer one at a time, without storing all of them.
+             *
+             * (see: https://en.wikipedia.org/wiki/Flow_network#Flow_decomposition)
+             *
+             * V: number of nodes
+             * E: number of edges
+             * Time complexity: O(V * E) (O(E + total length of the paths) in practice)
+             *
+             * @param flow_graph the graph with the flow of each edge as capacity (e.g. the optimal graph)
+             * @param source     the source node
+             * @param sink       the sink node
+             * @param consumer   function called for each path (from source to sink) or cycle (first node = last node)
+             *                   with its nodes and its flow
+             *
+             * @return the number of paths and cycles emitted
+             *
+             * @throws invalid_argument if the flow is not conserved in a node different from source and sink
+             */
+            static int DecomposeFlow(const std::shared_ptr<data_structures::Graph>& flow_graph, int source, int sink,
+                const std::function<void(const std::vector<int>& path, int flow)>& consumer);
+
             /**
              * Retrieve the path from the input node to the source (node with -1 as parent).
              *
@@ -0,0 +1,178 @@
+#include "LargeArrays.h"
+
+#include <new>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+
+namespace utils {
+    namespace {
+        std::atomic<PagePolicy> page_policy { PagePolicy::Default };
+        std::atomic<NumaPolicy> numa_policy { NumaPolicy::FirstTouch };
+
+        std::atomic<std::size_t> allocations {};
+        std::atomic<std::size_t> bytes {};
+        std::atomic<std::size_t> peak_bytes {};
+        std::atomic<std::size_t> explicit_huge_page_bytes {};
+        std::atomic<std::size_t> transparent_huge_page_bytes {};
+        std::atomic<std::size_t> interleaved_bytes {};
+        std::atomic<std::size_t> fallbacks {};
+
+        // size of a mapping: the arrays are rounded up to huge pages, so they can be unmapped from their size
+        std::size_t MappingSize(std::size_t size) {
+            return (size + LargeArrays::huge_page_size - 1) / LargeArrays::huge_page_size * LargeArrays::huge_page_size;
+        }
+
+        // mask of the online NUMA nodes (e.g. "0-1,3" in sysfs), empty if the system does not report them
+        const std::vector<unsigned long>& OnlineNodes() {
+            static std::vector<unsigned long> mask;
+            static std::once_flag read;
+            std::call_once(read, []() {
+                std::ifstream file("/sys/devices/system/node/online");
+                std::string range;
+                while (std::getline(file, range, ',')) {
+                    std::istringstream stream(range);
+                    int first {-1};
+                    int last {-1};
+                    char dash {};
+                    stream >> first;
+                    if (!(stream >> dash >> last)) {
+                        last = first;
+                    }
+                    for (int node = first; node >= 0 && node <= last; node++) {
+                        std::size_t word { static_cast<std::size_t>(node) / (8 * sizeof(unsigned long)) };
+                        mask.resize(std::max(mask.size(), word + 1), 0);
+                        mask[word] |= 1UL << (node % (8 * sizeof(unsigned long)));
+                    }
+                }
+            });
+            return mask;
+        }
+
+        // map length bytes aligned to a huge page: the mapping is enlarged by a huge page and the ends are trimmed
+        void* MapAligned(std::size_t length) {
+            void* mapping { mmap(nullptr, length + LargeArrays::huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) };
+            if (mapping == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+
+            auto start = reinterpret_cast<std::uintptr_t>(mapping);
+            std::uintptr_t aligned { (start + LargeArrays::huge_page_size - 1) / LargeArrays::huge_page_size * LargeArrays::huge_page_size };
+            if (aligned > start) {
+                munmap(mapping, aligned - start);
+            }
+            std::size_t tail { start + length + LargeArrays::huge_page_size - (aligned + length) };
+            if (tail > 0) {
+                munmap(reinterpret_cast<void*>(aligned + length), tail);
+            }
+            return reinterpret_cast<void*>(aligned);
+        }
+    }
+
+    void LargeArrays::SetPolicy(PagePolicy new_page_policy, NumaPolicy new_numa_policy) {
+        page_policy = new_page_policy;
+        numa_policy = new_numa_policy;
+    }
+
+    void LargeArrays::SetPolicy(const std::string& policy) {
+        std::string pages { policy.substr(0, policy.find(',')) };
+        std::string placement { policy.find(',') == std::string::npos ? "" : policy.substr(policy.find(',') + 1) };
+
+        PagePolicy new_page_policy {};
+        if (pages == "default") {
+            new_page_policy = PagePolicy::Default;
+        } else if (pages == "thp") {
+            new_page_policy = PagePolicy::TransparentHugePages;
+        } else if (pages == "hugetlb") {
+            new_page_policy = PagePolicy::ExplicitHugePages;
+        } else {
+            throw std::invalid_argument("Unknown page policy " + pages + " (default, thp or hugetlb)");
+        }
+
+        if (!placement.empty() && placement != "interleave") {
+            throw std::invalid_argument("Unknown NUMA policy " + placement + " (interleave)");
+        }
+        LargeArrays::SetPolicy(new_page_policy, placement.empty() ? NumaPolicy::FirstTouch : NumaPolicy::Interleave);
+    }
+
+    PagePolicy LargeArrays::GetPagePolicy() {
+        return page_policy;
+    }
+
+    NumaPolicy LargeArrays::GetNumaPolicy() {
+        return numa_policy;
+    }
+
+    AllocationStats LargeArrays::GetStats() {
+        return { allocations, bytes, peak_bytes, explicit_huge_page_bytes, transparent_huge_page_bytes, interleaved_bytes, fallbacks };
+    }
+
+    void* LargeArrays::Allocate(std::size_t size) {
+        if (size < LargeArrays::huge_page_size) {
+            return ::operator new(size);
+        }
+
+        std::size_t length { MappingSize(size) };
+        PagePolicy pages { page_policy };
+        void* array { nullptr };
+
+        // the reserved pool can be empty or missing, then the array gets transparent huge pages
+        if (pages == PagePolicy::ExplicitHugePages) {
+            void* mapping { mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0) };
+            if (mapping != MAP_FAILED) {
+                array = mapping;
+                explicit_huge_page_bytes += length;
+            } else {
+                fallbacks++;
+                pages = PagePolicy::TransparentHugePages;
+            }
+        }
+        if (!array) {
+            array = MapAligned(length);
+            if (pages == PagePolicy::TransparentHugePages) {
+                if (madvise(array, length, MADV_HUGEPAGE) == 0) {
+                    transparent_huge_page_bytes += length;
+                } else {
+                    fallbacks++;
+                }
+            }
+        }
+
+        // the policy must be set before the pages are touched, otherwise they are already placed
+        if (numa_policy == NumaPolicy::Interleave) {
+            const auto& nodes { OnlineNodes() };
+            if (!nodes.empty() && syscall(SYS_mbind, array, length, MPOL_INTERLEAVE, nodes.data(), nodes.size() * 8 * sizeof(unsigned long) + 1, 0) == 0) {
+                interleaved_bytes += length;
+            } else {
+                fallbacks++;
+            }
+        }
+
+        allocations++;
+        std::size_t current { bytes += length };
+        std::size_t peak { peak_bytes };
+        while (current > peak && !peak_bytes.compare_exchange_weak(peak, current)) {}
+        return array;
+    }
+
+    void LargeArrays::Deallocate(void* array, std::size_t size) noexcept {
+        if (size < LargeArrays::huge_page_size) {
+            ::operator delete(array);
+            return;
+        }
+
+        munmap(array, MappingSize(size));
+        bytes -= MappingSize(size);
+    }
+}
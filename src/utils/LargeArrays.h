@@ -0,0 +1,156 @@
+#ifndef NETWORK_FLOWS_LARGEARRAYS_H
+#define NETWORK_FLOWS_LARGEARRAYS_H
+
+#include <vector>
+#include <string>
+#include <cstddef>
+
+namespace utils {
+    /**
+     * Page size used for the large arrays.
+     */
+    enum class PagePolicy {
+        // regular pages
+        Default,
+        // transparent huge pages: the array is aligned to a huge page and the kernel is advised to back it with them
+        TransparentHugePages,
+        // explicit huge pages from the reserved pool (vm.nr_hugepages), transparent ones when the pool is empty
+        ExplicitHugePages
+    };
+
+    /**
+     * Placement of the pages of the large arrays on the NUMA nodes.
+     */
+    enum class NumaPolicy {
+        // each page is placed on the node of the thread that touches it first (default of the kernel)
+        FirstTouch,
+        // the pages are interleaved round-robin on all the nodes, so all the memory controllers serve the array
+        Interleave
+    };
+
+    /**
+     * Statistics of the large array allocations since the start of the program (see LargeArrays::GetStats()).
+     */
+    struct AllocationStats {
+        // number of large arrays allocated
+        std::size_t allocations;
+
+        // bytes currently mapped for the large arrays and their maximum (rounded up to huge pages)
+        std::size_t bytes;
+        std::size_t peak_bytes;
+
+        // total bytes mapped with explicit huge pages, advised for transparent huge pages, interleaved on the NUMA nodes
+        std::size_t explicit_huge_page_bytes;
+        std::size_t transparent_huge_page_bytes;
+        std::size_t interleaved_bytes;
+
+        // allocations that did not get the requested policy (no reserved huge pages, no NUMA support)
+        std::size_t fallbacks;
+    };
+
+    /**
+     * Allocation policy of the large arrays of the solvers (compressed graphs, flows and labels of the traversals),
+     * where TLB misses and the placement on the NUMA nodes matter.
+     * The arrays of at least one huge page (2 MiB) are mapped directly from the operating system with the current
+     * policy, the smaller ones use the default allocator. The policy is global and it applies to the arrays
+     * allocated after it is set; the arrays keep the policy they were allocated with.
+     *
+     * (see: https://www.kernel.org/doc/html/latest/admin-guide/mm/transhuge.html)
+     */
+    class LargeArrays {
+        public:
+            // size of a huge page, the arrays of at least this size are mapped with the policy
+            static constexpr std::size_t huge_page_size { std::size_t{1} << 21 };
+
+            /**
+             * Set the allocation policy of the large arrays.
+             *
+             * @param page_policy the page size
+             * @param numa_policy the placement on the NUMA nodes
+             */
+            static void SetPolicy(PagePolicy page_policy, NumaPolicy numa_policy);
+
+            /**
+             * Set the allocation policy of the large arrays from its name: "default", "thp" (transparent huge pages)
+             * or "hugetlb" (explicit huge pages), optionally followed by ",interleave" (e.g. "thp,interleave").
+             *
+             * @param policy the name of the policy
+             *
+             * @throws invalid_argument if the name is not a policy
+             */
+            static void SetPolicy(const std::string& policy);
+
+            /**
+             * Get the page size of the large arrays.
+             *
+             * @return the page policy
+             */
+            [[nodiscard]] static PagePolicy GetPagePolicy();
+
+            /**
+             * Get the placement of the large arrays on the NUMA nodes.
+             *
+             * @return the NUMA policy
+             */
+            [[nodiscard]] static NumaPolicy GetNumaPolicy();
+
+            /**
+             * Get the statistics of the large array allocations.
+             *
+             * @return the statistics
+             */
+            [[nodiscard]] static AllocationStats GetStats();
+
+            /**
+             * Allocate an array with the current policy.
+             *
+             * @param size the size of the array in bytes
+             *
+             * @return the array, aligned to a huge page if it is a large array
+             *
+             * @throws bad_alloc if the memory cannot be allocated
+             */
+            static void* Allocate(std::size_t size);
+
+            /**
+             * Free an array allocated with Allocate().
+             *
+             * @param array the array
+             * @param size  the size of the array in bytes (the same passed to Allocate())
+             */
+            static void Deallocate(void* array, std::size_t size) noexcept;
+    };
+
+    /**
+     * Allocator of the standard containers using LargeArrays, so their buffer gets the allocation policy.
+     */
+    template<typename T>
+    class LargeArrayAllocator {
+        public:
+            using value_type = T;
+
+            LargeArrayAllocator() = default;
+
+            template<typename U>
+            LargeArrayAllocator(const LargeArrayAllocator<U>&) {}
+
+            [[nodiscard]] T* allocate(std::size_t n) {
+                return static_cast<T*>(LargeArrays::Allocate(n * sizeof(T)));
+            }
+
+            void deallocate(T* array, std::size_t n) noexcept {
+                LargeArrays::Deallocate(array, n * sizeof(T));
+            }
+
+            template<typename U>
+            bool operator==(const LargeArrayAllocator<U>&) const {
+                return true;
+            }
+    };
+
+    // vector whose buffer gets the allocation policy of the large arrays
+    template<typename T>
+    using LargeVector = std::vector<T, LargeArrayAllocator<T>>;
+}
+
+#endif //NETWORK_FLOWS_LARGEARRAYS_H
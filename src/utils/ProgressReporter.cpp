@@ -0,0 +1,77 @@
+#include "ProgressReporter.h"
+
+#include <utility>
+
+namespace utils {
+    namespace {
+        // reporter of the current thread, nullptr if the progress is not reported
+        thread_local ProgressReporter* current { nullptr };
+    }
+
+    ProgressReporter::ProgressReporter(std::function<void(const dto::SolveProgress&)> callback) :
+        callback(std::move(callback)),
+        parent(nullptr),
+        augmentations(0),
+        flow(0),
+        cost(0),
+        pauses(0),
+        previous(current) {
+        current = this;
+    }
+
+    ProgressReporter::ProgressReporter(ProgressReporter* parent) :
+        parent(parent),
+        augmentations(0),
+        flow(0),
+        cost(0),
+        pauses(0),
+        previous(current) {
+        current = this;
+    }
+
+    ProgressReporter::~ProgressReporter() {
+        current = this->previous;
+    }
+
+    ProgressReporter* ProgressReporter::Current() {
+        return current;
+    }
+
+    bool ProgressReporter::IsReporting() {
+        // the augmentations go up to the reporter with the callback, none of the reporters on the way can be paused
+        const ProgressReporter* reporter { current };
+        while (reporter && !reporter->pauses && reporter->parent) {
+            reporter = reporter->parent;
+        }
+        return reporter && !reporter->pauses && reporter->callback;
+    }
+
+    void ProgressReporter::Augment(int flow, int cost) {
+        if (!ProgressReporter::IsReporting()) {
+            return;
+        }
+
+        ProgressReporter* reporter { current };
+        while (reporter->parent) {
+            reporter = reporter->parent;
+        }
+
+        std::lock_guard<std::mutex> lock(reporter->mutex);
+        reporter->augmentations++;
+        reporter->flow += flow;
+        reporter->cost += cost;
+        reporter->callback(dto::SolveProgress(reporter->augmentations, reporter->flow, reporter->cost));
+    }
+
+    ProgressReporter::Pause::Pause() : reporter(current) {
+        if (this->reporter) {
+            this->reporter->pauses++;
+        }
+    }
+
+    ProgressReporter::Pause::~Pause() {
+        if (this->reporter) {
+            this->reporter->pauses--;
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef NETWORK_FLOWS_PROGRESSREPORTER_H
+#define NETWORK_FLOWS_PROGRESSREPORTER_H
+
+#include "dto/solveProgress/SolveProgress.h"
+
+#include <mutex>
+#include <functional>
+
+namespace utils {
+    /**
+     * Progress of the solves running on the current thread.
+     * A reporter installs a callback on the thread that creates it, until it is destroyed: the solvers call
+     * Augment() after each augmentation and the callback gets the augmentations, the flow and the cost so far
+     * (see dto::SolveProgress). Without a reporter Augment() does nothing, so the solvers can always call it.
+     * The flow and the cost are summed over the solvers called, so a solve split in sub-problems
+     * (e.g. MinimumCostFlowAlgorithms::SolveByComponents()) reports the whole flow; the solvers running
+     * auxiliary flows that are not part of the result (e.g. the max flow computing the flow value) pause the reporter.
+     * The matrix solvers (SmallGraph, DenseGraph) report their whole flow at the end, as a single augmentation.
+     * A solver running on more threads installs on each of them a reporter forwarding to the one of the calling thread.
+     */
+    class ProgressReporter {
+        public:
+            /**
+             * Install the callback on the current thread, the previous reporter (if any) is restored when this one is destroyed.
+             *
+             * @param callback the function called after each augmentation, on the thread of the augmentation
+             *                 (one call at a time if the augmentations come from more threads)
+             */
+            explicit ProgressReporter(std::function<void(const dto::SolveProgress&)> callback);
+
+            /**
+             * Install on the current thread a reporter forwarding the augmentations to another one (see Current()).
+             *
+             * @param parent the reporter receiving the augmentations, nullptr if the progress is not reported
+             */
+            explicit ProgressReporter(ProgressReporter* parent);
+
+            ProgressReporter(const ProgressReporter&) = delete;
+            ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+            ~ProgressReporter();
+
+            /**
+             * Get the reporter of the current thread, to forward to it the progress of other threads.
+             *
+             * @return the reporter, nullptr if there is none
+             */
+            [[nodiscard]] static ProgressReporter* Current();
+
+            /**
+             * Check if the progress is reported on the current thread, so the solvers compute the cost
+             * of an augmentation only if it is needed.
+             *
+             * @return true if there is a reporter with a callback and it is not paused, false otherwise
+             */
+            [[nodiscard]] static bool IsReporting();
+
+            /**
+             * Report an augmentation to the reporter of the current thread (if any and not paused).
+             *
+             * @param flow the flow sent by the augmentation
+             * @param cost the cost of the flow sent by the augmentation (negative if it cancels a cycle)
+             */
+            static void Augment(int flow, int cost);
+
+            /**
+             * Pause the reporter of the current thread until it is destroyed (the pauses can be nested).
+             */
+            class Pause {
+                public:
+                    Pause();
+
+                    Pause(const Pause&) = delete;
+                    Pause& operator=(const Pause&) = delete;
+
+                    ~Pause();
+
+                private:
+                    // the paused reporter, nullptr if there was none
+                    ProgressReporter* reporter;
+            };
+
+        private:
+            std::function<void(const dto::SolveProgress&)> callback;
+
+            // the reporter receiving the augmentations of this one, nullptr if it has the callback
+            ProgressReporter* parent;
+
+            // guards the counters and the callback, used only by the reporter with the callback
+            std::mutex mutex;
+
+            int augmentations;
+            int flow;
+            int cost;
+
+            // number of pauses active on the thread of the reporter
+            int pauses;
+
+            // reporter of the thread before this one was installed
+            ProgressReporter* previous;
+    };
+}
+
+#endif //NETWORK_FLOWS_PROGRESSREPORTER_H